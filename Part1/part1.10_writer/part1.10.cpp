@@ -0,0 +1,115 @@
+#include<algorithm>
+#include<cstdio>
+#include<fstream>
+#include<iostream>
+#include<iterator>
+#include<map>
+#include<random>
+#include<regex>
+#include<set>
+#include<sstream>
+#include<string>
+#include<vector>
+
+#include"variables_writer.hpp"
+#include"../variables_format.hpp"
+#include"../../tracing.hpp"
+
+std::regex match_variables(
+    "^([A-Za-z_][A-Za-z_0-9()]*)\\s*=\\s*(.*)$", 
+    std::regex_constants::ECMAScript);
+
+// Returns the variables in the order of their first definition, a 
+// variable defined twice keeps the last value.
+std::vector<std::pair<std::string, std::string>> find_all_variables_in_order(
+    const std::string& filename)
+{
+    std::vector<std::pair<std::string, std::string>> variables;
+    std::map<std::string, size_t> positions;
+    std::ifstream stream(filename);
+    std::string line;
+    std::smatch match;
+    while(std::getline(stream, line))
+    {
+        TRACE_COUNT(bytes_read, line.size());
+        TRACE_COUNT(lines_scanned, 1);
+        if(line.size() > max_line_length)
+            continue;
+        bool is_matching;
+        {
+            TRACE_TIME(match_time_ns);
+            is_matching = std::regex_match(line, match, match_variables);
+        }
+        if(!is_matching)
+            continue;
+        auto [position, is_new] = positions.emplace(match[1].str(), variables.size());
+        if(is_new)
+            variables.emplace_back(match[1].str(), match[2].str());
+        else
+            variables[position->second].second = match[2].str();
+    }
+    return variables;
+}
+
+std::map<std::string, std::string> find_all_variables(const std::string& filename)
+{
+    auto variables = find_all_variables_in_order(filename);
+    return std::map<std::string, std::string>(variables.begin(), variables.end());
+}
+
+std::string content_of(const std::string& filename)
+{
+    std::ifstream stream(filename, std::ios::binary);
+    std::ostringstream content;
+    content << stream.rdbuf();
+    return content.str();
+}
+
+int main()
+{
+    auto variables = find_all_variables_in_order("C:\\Temp\\variables");
+    std::cout << "Number of variables: " << variables.size() << "\n";
+
+    // Enough variables for several chunks, in a shuffled order so that 
+    // the insertion order differs from the sorted order.
+    const size_t number_of_variables = 100000;
+    std::set<std::string> names;
+    for(auto& [name, value]: variables)
+        names.insert(name);
+    std::vector<std::pair<std::string, std::string>> generated_variables;
+    for(size_t index = 0; variables.size() + generated_variables.size() < number_of_variables; index ++)
+    {
+        std::string name = "GENERATED_" + std::to_string(index);
+        if(names.count(name) == 0)
+            generated_variables.emplace_back(name, 
+                std::string(index % 50, 'v') + std::to_string(index * 7919));
+    }
+    std::shuffle(generated_variables.begin(), generated_variables.end(), std::mt19937(0));
+    variables.insert(variables.end(), generated_variables.begin(), generated_variables.end());
+
+    auto sorted_variables = variables;
+    std::sort(sorted_variables.begin(), sorted_variables.end());
+
+    bool is_same_output = true;
+    bool is_round_trip = true;
+    for(auto order: { output_order::insertion, output_order::sorted })
+    {
+        std::string reference_content;
+        for(size_t number_of_threads: { 1, 3, 8 })
+        {
+            std::string filename = "variables." + std::to_string(number_of_threads);
+            write_all_variables(filename, variables, order, number_of_threads);
+            std::string content = content_of(filename);
+            if(number_of_threads == 1)
+                reference_content = content;
+            is_same_output = is_same_output && content == reference_content;
+            is_round_trip = is_round_trip && find_all_variables_in_order(filename) 
+                == (order == output_order::insertion ? variables : sorted_variables);
+            std::remove(filename.c_str());
+        }
+    }
+    std::cout << "Written variables: " << variables.size() << "\n";
+    std::cout << "Identical output with 1, 3 and 8 threads: " << (is_same_output ? "yes" : "no")
+        << ", round trip: " << (is_round_trip ? "yes" : "no") << "\n";
+    return is_same_output && is_round_trip ? 0 : 1;
+}
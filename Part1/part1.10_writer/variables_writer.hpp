@@ -0,0 +1,192 @@
+#pragma once
+
+#include<algorithm>
+#include<atomic>
+#include<fstream>
+#include<map>
+#include<stdexcept>
+#include<string>
+#include<string_view>
+#include<thread>
+#include<utility>
+#include<vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include<fcntl.h>
+#include<unistd.h>
+#endif
+
+#include"../variables_format.hpp"
+
+// Writes the variables as "NAME=VALUE" lines that find_all_variables 
+// reads back. The lines are formatted in parallel by chunks of a fixed 
+// number of variables: the chunks do not depend on the number of 
+// threads, so the file is the same whatever the number of threads. Each
+// chunk is then written with a single call at its offset in the file.
+// A variable that would not be read back as is throws 
+// std::invalid_argument before the file is opened.
+
+enum class output_order
+{
+    sorted,     // the variables are sorted by name.
+    insertion   // the variables are written in the order they are given.
+};
+
+namespace detail
+{
+
+using variable = std::pair<std::string, std::string>;
+
+constexpr size_t variables_per_chunk = 4096;
+
+inline void write_chunks(const std::string& filename, 
+    const std::vector<std::string>& chunks, size_t number_of_threads)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    int file = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(file < 0)
+        throw std::runtime_error("cannot open " + filename);
+
+    std::vector<off_t> offsets(chunks.size() + 1, 0);
+    for(size_t index = 0; index < chunks.size(); index ++)
+        offsets[index + 1] = offsets[index] + (off_t)chunks[index].size();
+
+    std::atomic<size_t> next_chunk(0);
+    std::atomic<bool> has_failed(false);
+    auto write = [&]()
+    {
+        for(size_t index = next_chunk++; index < chunks.size(); index = next_chunk++)
+        {
+            const char* data = chunks[index].data();
+            size_t remaining = chunks[index].size();
+            off_t offset = offsets[index];
+            while(remaining != 0)
+            {
+                ssize_t written = ::pwrite(file, data, remaining, offset);
+                if(written <= 0)
+                {
+                    has_failed = true;
+                    return;
+                }
+                data += written;
+                remaining -= (size_t)written;
+                offset += written;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for(size_t index = 1; index < number_of_threads; index ++)
+        threads.emplace_back(write);
+    write();
+    for(auto& thread: threads)
+        thread.join();
+    if(::close(file) != 0 || has_failed)
+        throw std::runtime_error("cannot write " + filename);
+#else
+    (void)number_of_threads;
+    std::ofstream stream(filename, std::ios::binary);
+    for(const auto& chunk: chunks)
+        stream.write(chunk.data(), (std::streamsize)chunk.size());
+    if(!stream)
+        throw std::runtime_error("cannot write " + filename);
+#endif
+}
+
+// The name must match [A-Za-z_][A-Za-z_0-9()]*. The value must not 
+// start with a space, which the reader skips after the '=', nor contain 
+// an end of line, and the line must not be longer than max_line_length.
+inline void check_variable(const std::string& name, const std::string& value)
+{
+    auto is_letter = [](char c) 
+    { 
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_'; 
+    };
+    auto is_name_char = [&is_letter](char c)
+    {
+        return is_letter(c) || (c >= '0' && c <= '9') || c == '(' || c == ')';
+    };
+    if(name.empty() || !is_letter(name.front()) 
+        || !std::all_of(name.begin(), name.end(), is_name_char))
+        throw std::invalid_argument("invalid variable name: " + name);
+    const std::string_view spaces = " \t\n\v\f\r";
+    if(!value.empty() && spaces.find(value.front()) != std::string_view::npos)
+        throw std::invalid_argument("value starting with a space: " + name);
+    if(value.find_first_of("\n\r") != std::string::npos)
+        throw std::invalid_argument("value with an end of line: " + name);
+    if(name.size() + 1 + value.size() > max_line_length)
+        throw std::invalid_argument("line too long: " + name);
+}
+
+template<class Variable>
+void write_variables(const std::string& filename, 
+    const std::vector<const Variable*>& variables, size_t number_of_threads)
+{
+    for(const Variable* variable: variables)
+        check_variable(variable->first, variable->second);
+
+    number_of_threads = std::max<size_t>(1, number_of_threads);
+    std::vector<std::string> chunks(
+        (variables.size() + variables_per_chunk - 1) / variables_per_chunk);
+
+    std::atomic<size_t> next_chunk(0);
+    auto format = [&]()
+    {
+        for(size_t index = next_chunk++; index < chunks.size(); index = next_chunk++)
+        {
+            size_t first = index * variables_per_chunk;
+            size_t last = std::min(first + variables_per_chunk, variables.size());
+            size_t length = 0;
+            for(size_t position = first; position < last; position ++)
+                length += variables[position]->first.size() 
+                    + variables[position]->second.size() + 2;
+
+            std::string& chunk = chunks[index];
+            chunk.reserve(length);
+            for(size_t position = first; position < last; position ++)
+            {
+                chunk += variables[position]->first;
+                chunk += '=';
+                chunk += variables[position]->second;
+                chunk += '\n';
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for(size_t index = 1; index < number_of_threads; index ++)
+        threads.emplace_back(format);
+    format();
+    for(auto& thread: threads)
+        thread.join();
+
+    write_chunks(filename, chunks, number_of_threads);
+}
+
+}
+
+inline void write_all_variables(const std::string& filename, 
+    const std::vector<std::pair<std::string, std::string>>& variables, 
+    output_order order, 
+    size_t number_of_threads = std::thread::hardware_concurrency())
+{
+    std::vector<const detail::variable*> ordered_variables;
+    ordered_variables.reserve(variables.size());
+    for(const auto& variable: variables)
+        ordered_variables.push_back(&variable);
+    if(order == output_order::sorted)
+        std::stable_sort(ordered_variables.begin(), ordered_variables.end(),
+            [](const detail::variable* first, const detail::variable* second)
+            { return first->first < second->first; });
+    detail::write_variables(filename, ordered_variables, number_of_threads);
+}
+
+inline void write_all_variables(const std::string& filename, 
+    const std::map<std::string, std::string>& variables,
+    size_t number_of_threads = std::thread::hardware_concurrency())
+{
+    using variable = std::map<std::string, std::string>::value_type;
+    std::vector<const variable*> ordered_variables;
+    ordered_variables.reserve(variables.size());
+    for(const auto& variable: variables)
+        ordered_variables.push_back(&variable);
+    detail::write_variables(filename, ordered_variables, number_of_threads);
+}
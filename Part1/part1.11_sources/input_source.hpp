@@ -0,0 +1,232 @@
+#pragma once
+
+#include<cerrno>
+#include<cstdlib>
+#include<cstring>
+#include<fstream>
+#include<iostream>
+#include<istream>
+#include<iterator>
+#include<memory>
+#include<span>
+#include<stdexcept>
+#include<string>
+#include<vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
+
+// Source of characters for the parser. The parser asks for the next 
+// chunk until an empty chunk is returned, a chunk remains valid until the
+// next call. Each source reads its data in the way that suits it best.
+class input_source
+{
+public:
+    virtual ~input_source() = default;
+    virtual std::span<const char> next() = 0;
+};
+
+// Characters already in memory, returned as a single chunk.
+class memory_source: public input_source
+{
+private:
+    std::span<const char> m_content;
+    bool m_is_consumed;
+
+public:
+    explicit memory_source(std::span<const char> theContent):
+        m_content(theContent), m_is_consumed(false)
+        {}
+    std::span<const char> next() override
+    {
+        if(m_is_consumed)
+            return {};
+        m_is_consumed = true;
+        return m_content;
+    }
+};
+
+// Any standard stream, e.g. std::cin when the data comes from a pipe.
+class stream_source: public input_source
+{
+private:
+    std::istream& m_stream;
+    std::vector<char> m_buffer;
+
+public:
+    explicit stream_source(std::istream& theStream, size_t buffer_size = 64 * 1024):
+        m_stream(theStream), m_buffer(buffer_size)
+        {}
+    std::span<const char> next() override
+    {
+        if(!m_stream)
+            return {};
+        m_stream.read(m_buffer.data(), (std::streamsize)m_buffer.size());
+        return std::span<const char>(m_buffer.data(), (size_t)m_stream.gcount());
+    }
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// File read with read() in large aligned blocks. The kernel is told that 
+// the file is read sequentially, so it reads ahead aggressively. With
+// bypass_cache, the file is opened with O_DIRECT, which avoids polluting
+// the page cache with cold data; if the file system does not support it,
+// the file is read through the cache.
+class file_source: public input_source
+{
+private:
+    static const size_t alignment = 4096;
+
+    int m_file;
+    size_t m_buffer_size;
+    std::unique_ptr<char, decltype(&std::free)> m_buffer;
+
+public:
+    explicit file_source(const std::string& filename, 
+        bool bypass_cache = false, size_t buffer_size = 1024 * 1024):
+        m_file(-1), 
+        m_buffer_size((buffer_size + alignment - 1) / alignment * alignment),
+        m_buffer(static_cast<char*>(std::aligned_alloc(alignment, m_buffer_size)), &std::free)
+    {
+        if(m_buffer == nullptr)
+            throw std::bad_alloc();
+#if defined(O_DIRECT)
+        if(bypass_cache)
+            m_file = ::open(filename.c_str(), O_RDONLY | O_DIRECT);
+#else
+        (void)bypass_cache;
+#endif
+        if(m_file < 0)
+            m_file = ::open(filename.c_str(), O_RDONLY);
+        if(m_file < 0)
+            throw std::runtime_error("cannot open " + filename);
+#if defined(POSIX_FADV_SEQUENTIAL)
+        ::posix_fadvise(m_file, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+    file_source(const file_source&) = delete;
+    ~file_source() override
+    {
+        ::close(m_file);
+    }
+    file_source& operator = (const file_source&) = delete;
+
+    std::span<const char> next() override
+    {
+        ssize_t number_of_bytes;
+        do
+            number_of_bytes = ::read(m_file, m_buffer.get(), m_buffer_size);
+        while(number_of_bytes < 0 && errno == EINTR);
+        if(number_of_bytes < 0)
+            throw std::runtime_error("cannot read the file");
+        return std::span<const char>(m_buffer.get(), (size_t)number_of_bytes);
+    }
+};
+
+// File mapped in memory and returned as a single chunk, no copy is made.
+class mapped_file_source: public input_source
+{
+private:
+    void* m_memory;
+    size_t m_size;
+    bool m_is_consumed;
+
+public:
+    explicit mapped_file_source(const std::string& filename):
+        m_memory(nullptr), m_size(0), m_is_consumed(false)
+    {
+        int file = ::open(filename.c_str(), O_RDONLY);
+        if(file < 0)
+            throw std::runtime_error("cannot open " + filename);
+        struct stat status;
+        if(::fstat(file, &status) == 0 && status.st_size > 0)
+        {
+            m_size = (size_t)status.st_size;
+            m_memory = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+        }
+        ::close(file);
+        if(m_memory == MAP_FAILED)
+            throw std::runtime_error("cannot map " + filename);
+        if(m_memory != nullptr)
+            ::madvise(m_memory, m_size, MADV_SEQUENTIAL);
+    }
+    mapped_file_source(const mapped_file_source&) = delete;
+    ~mapped_file_source() override
+    {
+        if(m_memory != nullptr)
+            ::munmap(m_memory, m_size);
+    }
+    mapped_file_source& operator = (const mapped_file_source&) = delete;
+
+    std::span<const char> next() override
+    {
+        if(m_is_consumed || m_memory == nullptr)
+            return {};
+        m_is_consumed = true;
+        return std::span<const char>(static_cast<const char*>(m_memory), m_size);
+    }
+};
+
+#else
+
+// Without POSIX, the files are read with std::ifstream.
+class file_source: public input_source
+{
+private:
+    std::ifstream m_stream;
+    stream_source m_source;
+
+public:
+    explicit file_source(const std::string& filename, 
+        bool = false, size_t buffer_size = 1024 * 1024):
+        m_stream(filename, std::ios::binary), m_source(m_stream, buffer_size)
+    {
+        if(!m_stream)
+            throw std::runtime_error("cannot open " + filename);
+    }
+    std::span<const char> next() override { return m_source.next(); }
+};
+
+// The file is loaded in memory instead of being mapped.
+class mapped_file_source: public input_source
+{
+private:
+    std::vector<char> m_content;
+    memory_source m_source;
+
+public:
+    explicit mapped_file_source(const std::string& filename):
+        m_content(), m_source(std::span<const char>())
+    {
+        std::ifstream stream(filename, std::ios::binary);
+        if(!stream)
+            throw std::runtime_error("cannot open " + filename);
+        m_content.assign(std::istreambuf_iterator<char>(stream), 
+            std::istreambuf_iterator<char>());
+        m_source = memory_source(m_content);
+    }
+    std::span<const char> next() override { return m_source.next(); }
+};
+
+#endif
+
+// Creates the source described by name:
+//   "-"               the standard input,
+//   "mmap:<path>"     the file mapped in memory,
+//   "direct:<path>"   the file read without the page cache,
+//   "<path>"          the file read by large blocks.
+inline std::unique_ptr<input_source> open_source(const std::string& name)
+{
+    if(name == "-")
+        return std::make_unique<stream_source>(std::cin);
+    if(name.rfind("mmap:", 0) == 0)
+        return std::make_unique<mapped_file_source>(name.substr(5));
+    if(name.rfind("direct:", 0) == 0)
+        return std::make_unique<file_source>(name.substr(7), true);
+    return std::make_unique<file_source>(name);
+}
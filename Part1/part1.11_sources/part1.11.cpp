@@ -0,0 +1,115 @@
+#include<algorithm>
+#include<iostream>
+#include<iterator>
+#include<map>
+#include<regex>
+#include<stdexcept>
+#include<string>
+#include<string_view>
+
+#include"input_source.hpp"
+#include"../variables_format.hpp"
+#include"../../tracing.hpp"
+
+std::regex match_variables(
+    "^([A-Za-z_][A-Za-z_0-9()]*)\\s*=\\s*(.*)$", 
+    std::regex_constants::ECMAScript);
+
+// The parser only sees chunks of characters, it does not know where they
+// come from. A line is copied only when it spans over two chunks.
+std::map<std::string, std::string> find_all_variables(input_source& source)
+{
+    using iterator = const char*;
+
+    std::map<std::string, std::string> variables;
+    auto match_line = [&variables](iterator start_of_line, iterator end_of_line)
+    {
+        TRACE_COUNT(lines_scanned, 1);
+        if((size_t)(end_of_line - start_of_line) > max_line_length)
+            return;
+        std::match_results<iterator> match;
+        bool is_matching;
+        {
+            TRACE_TIME(match_time_ns);
+            is_matching = std::regex_match(start_of_line, end_of_line, match, match_variables);
+        }
+        if(is_matching)
+            variables[match[1].str()] = match[2].str();
+    };
+
+    // Part of a line that spans over two chunks. A line longer than 
+    // max_line_length is dropped as soon as it is known to be too long.
+    std::string pending_line;
+    bool is_too_long = false;
+    auto append_pending = [&](iterator first, iterator last)
+    {
+        if(is_too_long)
+            return;
+        if(pending_line.size() + (size_t)(last - first) > max_line_length)
+        {
+            is_too_long = true;
+            pending_line.clear();
+            return;
+        }
+        pending_line.append(first, last);
+    };
+
+    for(auto chunk = source.next(); !chunk.empty(); chunk = source.next())
+    {
+        iterator start_of_line = chunk.data();
+        iterator end_of_chunk = chunk.data() + chunk.size();
+        TRACE_COUNT(bytes_read, chunk.size());
+        for(iterator end_of_line = std::find(start_of_line, end_of_chunk, '\n');
+            end_of_line != end_of_chunk;
+            end_of_line = std::find(start_of_line, end_of_chunk, '\n'))
+        {
+            if(is_too_long)
+            {
+                TRACE_COUNT(lines_scanned, 1);
+                is_too_long = false;
+            }
+            else if(!pending_line.empty())
+            {
+                append_pending(start_of_line, end_of_line);
+                if(!is_too_long)
+                    match_line(pending_line.data(), pending_line.data() + pending_line.size());
+                is_too_long = false;
+                pending_line.clear();
+            }
+            else
+                match_line(start_of_line, end_of_line);
+            start_of_line = end_of_line + 1;
+        }
+        append_pending(start_of_line, end_of_chunk);
+    }
+    if(!is_too_long)
+        match_line(pending_line.data(), pending_line.data() + pending_line.size());
+    return variables;
+}
+
+std::map<std::string, std::string> find_all_variables(const std::string& name)
+{
+    auto source = open_source(name);
+    return find_all_variables(*source);
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string name = argc > 1 ? argv[1] : "C:\\Temp\\variables";
+    try
+    {
+        auto variables = find_all_variables(name);
+        std::cout << "Number of variables: " << variables.size() << "\n";
+    }
+    catch(const std::runtime_error& error)
+    {
+        std::cerr << name << ": " << error.what() << "\n";
+        return 1;
+    }
+
+    std::string_view content = "HOME=/home/user\nSHELL=/bin/sh\n";
+    memory_source source(content);
+    std::cout << "Number of variables in memory: " 
+        << find_all_variables(source).size() << "\n";
+}
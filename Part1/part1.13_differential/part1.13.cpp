@@ -0,0 +1,554 @@
+// Differential harness: every parser of Part1 is run on the same
+// generated inputs and its result is compared to a reference model. The
+// parsers are included in their own namespaces, their main function is
+// renamed. The standard headers are included first so that the include
+// guards keep them out of these namespaces.
+#include<algorithm>
+#include<array>
+#include<atomic>
+#include<cerrno>
+#include<charconv>
+#include<chrono>
+#include<concepts>
+#include<condition_variable>
+#include<cstdint>
+#include<cstdio>
+#include<cstdlib>
+#include<cstring>
+#include<deque>
+#include<exception>
+#include<filesystem>
+#include<fstream>
+#include<functional>
+#include<future>
+#include<iostream>
+#include<istream>
+#include<iterator>
+#include<limits>
+#include<map>
+#include<memory>
+#include<mutex>
+#include<random>
+#include<regex>
+#include<set>
+#include<span>
+#include<sstream>
+#include<stdexcept>
+#include<string>
+#include<string_view>
+#include<system_error>
+#include<thread>
+#include<utility>
+#include<variant>
+#include<vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
+
+// The headers shared by several parsers are also included once, in the
+// global namespace: their include guards would otherwise keep them in 
+// the namespace of the first parser that includes them.
+#include"../../tracing.hpp"
+#include"../variables_format.hpp"
+#include"../part1.3_containeur/buffer.hpp"
+#include"../part1.4_coroutine/generator.hpp"
+#include"../part1.5_batch/thread_pool.hpp"
+#include"../part1.9_numa/numa_allocator.hpp"
+#include"../part1.10_writer/variables_writer.hpp"
+
+// The renamed main functions have no return statement, and GCC treats
+// the included files as headers, whose coroutine frames should not hold
+// local lambdas.
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wreturn-type"
+#pragma GCC diagnostic ignored "-Wsubobject-linkage"
+#endif
+
+#define main part1_0_main
+namespace part1_0 {
+#include"../part1.0.cpp"
+}
+#undef main
+#define main part1_1_main
+namespace part1_1 {
+#include"../part1.1.cpp"
+}
+#undef main
+#define main part1_2_main
+namespace part1_2 {
+#include"../part1.2.cpp"
+}
+#undef main
+#define main part1_3_main
+namespace part1_3 {
+#include"../part1.3/part1.3.cpp"
+}
+#undef main
+#define main part1_3_containeur_main
+namespace part1_3_containeur {
+#include"../part1.3_containeur/part1.3.cpp"
+}
+#undef main
+#define main part1_4_main
+namespace part1_4 {
+#include"../part1.4_coroutine/part1.4.cpp"
+}
+#undef main
+#define main part1_5_main
+namespace part1_5 {
+#include"../part1.5_batch/part1.5.cpp"
+}
+#undef main
+#define main part1_6_main
+namespace part1_6 {
+#include"../part1.6_typed/part1.6.cpp"
+}
+#undef main
+#define main part1_7_main
+namespace part1_7 {
+#include"../part1.7_bounded/part1.7.cpp"
+}
+#undef main
+#define main part1_8_main
+namespace part1_8 {
+#include"../part1.8_trie/part1.8.cpp"
+}
+#undef main
+#define main part1_9_main
+namespace part1_9 {
+#include"../part1.9_numa/part1.9.cpp"
+}
+#undef main
+#define main part1_10_main
+namespace part1_10 {
+#include"../part1.10_writer/part1.10.cpp"
+}
+#undef main
+#define main part1_11_main
+namespace part1_11 {
+#include"../part1.11_sources/part1.11.cpp"
+}
+#undef main
+#define main part1_12_main
+namespace part1_12 {
+#include"../part1.12_tracing/part1.12.cpp"
+}
+#undef main
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+using variables_type = std::map<std::string, std::string>;
+
+// Specification of the format: the input is split into lines at each
+// '\n', a line defines a variable if it is not longer than 
+// max_line_length and if the whole line matches the regular expression,
+// the last definition of a variable wins.
+variables_type reference_variables(std::string_view content)
+{
+    static const std::regex line_pattern(
+        "^([A-Za-z_][A-Za-z_0-9()]*)\\s*=\\s*(.*)$", 
+        std::regex_constants::ECMAScript);
+    variables_type variables;
+    while(!content.empty())
+    {
+        size_t end_of_line = std::min(content.find('\n'), content.size());
+        std::match_results<std::string_view::const_iterator> match;
+        if(end_of_line <= max_line_length 
+            && std::regex_match(content.begin(), content.begin() + end_of_line, 
+            match, line_pattern))
+            variables[match[1].str()] = match[2].str();
+        content.remove_prefix(std::min(end_of_line + 1, content.size()));
+    }
+    return variables;
+}
+
+struct parser
+{
+    const char* name;
+    std::function<variables_type(const std::string& filename, std::string_view content)> parse;
+    // The lecture parsers are known to disagree with the specification,
+    // their divergences are reported but do not make the harness fail.
+    bool must_agree;
+    // The parsers that do not bound the length of the lines are not run
+    // on the inputs with longer lines, which would overflow the stack in
+    // std::regex.
+    bool bounds_line_length = true;
+    // Converts the variables of the specification into the result 
+    // expected from the parser, the variables themselves if empty.
+    std::function<variables_type(const variables_type&)> expected_from = nullptr;
+};
+
+bool agrees(const parser& current_parser, const std::string& filename, 
+    std::string_view content, const variables_type& expected)
+{
+    auto variables = current_parser.parse(filename, content);
+    if(current_parser.expected_from)
+        return variables == current_parser.expected_from(expected);
+    return variables == expected;
+}
+
+// Textual form of a typed value that tells its kind and its exact value.
+std::string describe(const part1_6::typed_value& value)
+{
+    using kind = part1_6::typed_value::kind;
+    switch(value.type())
+    {
+    case kind::integer: 
+        return "integer " + std::to_string(value.as_integer());
+    case kind::floating:
+    {
+        std::array<char, 32> characters;
+        auto [end, error] = std::to_chars(characters.data(), 
+            characters.data() + characters.size(), value.as_floating());
+        (void)error;
+        return "floating " + std::string(characters.data(), end);
+    }
+    case kind::boolean: 
+        return value.as_boolean() ? "boolean true" : "boolean false";
+    default:
+        return "string " + value.as_string();
+    }
+}
+
+// Returns true if no line of the content is longer than max_line_length.
+bool has_short_lines(std::string_view content)
+{
+    while(!content.empty())
+    {
+        size_t end_of_line = std::min(content.find('\n'), content.size());
+        if(end_of_line > max_line_length)
+            return false;
+        content.remove_prefix(std::min(end_of_line + 1, content.size()));
+    }
+    return true;
+}
+
+std::vector<parser> all_parsers()
+{
+    return {
+        { "part1.0", [](const std::string& filename, std::string_view) 
+            { return part1_0::find_all_variables(filename); }, false, false },
+        { "part1.1", [](const std::string& filename, std::string_view) 
+            { return part1_1::find_all_variables(filename); }, false, false },
+        { "part1.2", [](const std::string& filename, std::string_view) 
+            { return part1_2::find_all_variables(filename); }, false, false },
+        { "part1.3", [](const std::string& filename, std::string_view) 
+            { return part1_3::find_all_variables(filename); }, false, false },
+        { "part1.3 containeur", [](const std::string& filename, std::string_view) 
+            { return part1_3_containeur::find_all_variables(filename); }, true },
+        { "part1.4", [](const std::string& filename, std::string_view) 
+            { 
+                variables_type variables;
+                for(auto& [name, value]: part1_4::variables_in(filename))
+                    variables[name] = value;
+                return variables; 
+            }, true },
+        { "part1.4 async", [](const std::string& filename, std::string_view) 
+            { 
+                variables_type variables;
+                for(auto& [name, value]: part1_4::async_variables_in(filename))
+                    variables[name] = value;
+                return variables; 
+            }, true },
+        { "part1.5", [](const std::string& filename, std::string_view) 
+            { return part1_5::variables_parser().find_all_variables(filename); }, true },
+        { "part1.6", [](const std::string& filename, std::string_view) 
+            { 
+                variables_type variables;
+                for(auto& [name, value]: part1_6::find_all_variables(filename))
+                    variables[name] = describe(value);
+                return variables; 
+            }, true, true, [](const variables_type& expected)
+            {
+                variables_type variables;
+                for(auto& [name, value]: expected)
+                    variables[name] = describe(part1_6::parse_value(value));
+                return variables;
+            } },
+        { "part1.7", [](const std::string& filename, std::string_view) 
+            { 
+                part1_7::reading_limits limits;
+                limits.max_line_length = max_line_length;
+                limits.memory_budget = std::numeric_limits<size_t>::max();
+                part1_7::reading_report report;
+                return part1_7::find_all_variables(filename, limits, report); 
+            }, true },
+        { "part1.8", [](const std::string& filename, std::string_view) 
+            { return part1_8::find_all_variables(filename); }, true },
+        { "part1.9", [](const std::string& filename, std::string_view) 
+            { return part1_9::find_all_variables(filename); }, true },
+        { "part1.10", [](const std::string& filename, std::string_view) 
+            { 
+                auto variables = part1_10::find_all_variables_in_order(filename);
+                return variables_type(variables.begin(), variables.end()); 
+            }, true },
+        { "part1.11 file", [](const std::string& filename, std::string_view) 
+            { return part1_11::find_all_variables(filename); }, true },
+        { "part1.11 memory", [](const std::string&, std::string_view content) 
+            { 
+                part1_11::memory_source source(content);
+                return part1_11::find_all_variables(source); 
+            }, true },
+        { "part1.12", [](const std::string& filename, std::string_view) 
+            { return part1_12::find_all_variables(filename); }, true },
+    };
+}
+
+// Generates lines close to the format with the cases on which the 
+// parsers are likely to differ: spaces around '=', empty values, 
+// invalid names, '\r', lines longer than the buffers, no final '\n'.
+// With with_long_lines, some lines are close to max_line_length or far
+// longer.
+std::string generate_input(std::mt19937& generator, bool with_long_lines)
+{
+    auto random = [&generator](size_t bound) { return (size_t)(generator() % bound); };
+    const std::string name_characters = 
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz_0123456789()";
+    const std::string value_characters = 
+        "abcdefghijklmnopqrstuvwxyz0123456789 =\\:;/.-_\t\"";
+
+    std::string content;
+    size_t number_of_lines = random(40);
+    for(size_t line = 0; line < number_of_lines; line ++)
+    {
+        switch(random(10))
+        {
+        case 0: 
+            break;
+        case 1: 
+            content += "# comment " + std::to_string(random(1000)); 
+            break;
+        default:
+        {
+            size_t name_length = 1 + random(12);
+            for(size_t index = 0; index < name_length; index ++)
+                content += name_characters[random(random(8) == 0 ? 
+                    name_characters.size() : 26)];
+            content += std::string(random(3), ' ');
+            content += random(20) == 0 ? ":" : "=";
+            content += std::string(random(3), random(2) == 0 ? ' ' : '\t');
+            size_t value_length = random(30);
+            if(random(6) == 0)
+                value_length = 70 + random(2000);
+            else if(with_long_lines && random(30) == 0)
+                value_length = random(2) == 0 ? max_line_length - 16 + random(32) 
+                    : max_line_length + random(200000);
+            for(size_t index = 0; index < value_length; index ++)
+                content += value_characters[random(value_characters.size())];
+            if(random(10) == 0)
+                content += '\r';
+        }
+        }
+        if(line + 1 < number_of_lines || random(2) == 0)
+            content += '\n';
+    }
+    return content;
+}
+
+std::string escape(std::string_view content)
+{
+    std::string result;
+    for(char character: content)
+    {
+        switch(character)
+        {
+        case '\n': result += "\\n"; break;
+        case '\r': result += "\\r"; break;
+        case '\t': result += "\\t"; break;
+        case '\\': result += "\\\\"; break;
+        default: result += character;
+        }
+    }
+    return result;
+}
+
+// The first characters of the escaped content.
+std::string excerpt(std::string_view content)
+{
+    const size_t max_length = 400;
+    std::string result = escape(content.substr(0, max_length));
+    if(content.size() > max_length)
+        result += "... (" + std::to_string(content.size()) + " characters)";
+    return result;
+}
+
+void write_file(const std::string& filename, std::string_view content)
+{
+    std::ofstream stream(filename, std::ios::binary);
+    stream.write(content.data(), (std::streamsize)content.size());
+}
+
+// Returns the number of divergences of the parsers that must agree with 
+// the specification.
+int run_differential(unsigned seed, size_t number_of_inputs, const std::string& filename)
+{
+    auto parsers = all_parsers();
+    std::vector<size_t> runs(parsers.size(), 0);
+    std::vector<size_t> divergences(parsers.size(), 0);
+    std::vector<std::string> first_divergences(parsers.size());
+    std::mt19937 generator(seed);
+
+    for(size_t input = 0; input < number_of_inputs; input ++)
+    {
+        std::string content = generate_input(generator, true);
+        write_file(filename, content);
+        auto expected = reference_variables(content);
+        bool is_short = has_short_lines(content);
+        for(size_t index = 0; index < parsers.size(); index ++)
+        {
+            if(!parsers[index].bounds_line_length && !is_short)
+                continue;
+            runs[index] ++;
+            if(agrees(parsers[index], filename, content, expected))
+                continue;
+            if(divergences[index] ++ == 0)
+                first_divergences[index] = excerpt(content);
+        }
+    }
+
+    int failures = 0;
+    for(size_t index = 0; index < parsers.size(); index ++)
+    {
+        std::cout << parsers[index].name << ": " << divergences[index] 
+            << "/" << runs[index] << " divergences"
+            << (parsers[index].must_agree ? "" : " (informative)") << "\n";
+        if(divergences[index] != 0)
+            std::cout << "  first diverging input: \"" 
+                << first_divergences[index] << "\"\n";
+        if(parsers[index].must_agree)
+            failures += (int)divergences[index];
+    }
+    return failures;
+}
+
+// Measures the throughput of each parser in MB/s on a large input: the
+// parser is run once to warm up the caches, then the median of several
+// runs is kept. When the baseline file exists, fails if a parser is 
+// slower than the baseline by more than max_regression percents. The
+// throughputs of the parsers that are not in the baseline are recorded.
+int run_performance(const std::string& baseline_filename, double max_regression,
+    const std::string& filename)
+{
+    std::mt19937 generator(0);
+    std::string content;
+    while(content.size() < 8 * 1024 * 1024)
+        content += generate_input(generator, false) + "\n";
+    write_file(filename, content);
+
+    std::map<std::string, double> baseline;
+    {
+        std::ifstream stream(baseline_filename);
+        std::string name;
+        double throughput;
+        while(std::getline(stream, name, '\t') && stream >> throughput)
+        {
+            baseline[name] = throughput;
+            stream.ignore(1);
+        }
+    }
+
+    const size_t number_of_runs = 5;
+    int failures = 0;
+    std::map<std::string, double> measures;
+    for(auto& current_parser: all_parsers())
+    {
+        current_parser.parse(filename, content);
+        std::vector<double> throughputs;
+        for(size_t run = 0; run < number_of_runs; run ++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            current_parser.parse(filename, content);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            throughputs.push_back((double)content.size() / (1024 * 1024) / elapsed.count());
+        }
+        std::nth_element(throughputs.begin(), 
+            throughputs.begin() + number_of_runs / 2, throughputs.end());
+        double throughput = throughputs[number_of_runs / 2];
+        measures[current_parser.name] = throughput;
+
+        std::cout << current_parser.name << ": " << throughput << " MB/s";
+        auto reference = baseline.find(current_parser.name);
+        if(reference != baseline.end())
+        {
+            double change = (throughput - reference->second) / reference->second * 100;
+            std::cout << " (" << (change >= 0 ? "+" : "") << change << "%)";
+            if(-change > max_regression)
+            {
+                std::cout << " REGRESSION";
+                failures ++;
+            }
+        }
+        std::cout << "\n";
+    }
+
+    // The parsers missing from the baseline are added to it.
+    size_t number_of_known_parsers = baseline.size();
+    baseline.insert(measures.begin(), measures.end());
+    if(baseline.size() != number_of_known_parsers)
+    {
+        std::ofstream stream(baseline_filename);
+        for(auto& [name, throughput]: baseline)
+            stream << name << "\t" << throughput << "\n";
+        std::cout << "Baseline written to " << baseline_filename << "\n";
+    }
+    return failures;
+}
+
+#if defined(LIBFUZZER)
+
+// Entry point for libFuzzer (-fsanitize=fuzzer -DLIBFUZZER): aborts when 
+// a parser that must agree with the specification diverges.
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, size_t size)
+{
+    std::string_view content(reinterpret_cast<const char*>(data), size);
+    std::string filename = (std::filesystem::temp_directory_path() 
+        / ("fuzz_variables_" + std::to_string(::getpid()))).string();
+    write_file(filename, content);
+    auto expected = reference_variables(content);
+    for(auto& current_parser: all_parsers())
+    {
+        if(current_parser.must_agree 
+            && !agrees(current_parser, filename, content, expected))
+            std::abort();
+    }
+    return 0;
+}
+
+#else
+
+// Usage:
+//   differential_parsers [seed] [number_of_inputs]
+//   differential_parsers --perf <baseline_file> [max_regression_percent]
+int main(int argc, char* argv[])
+{
+    std::string filename = 
+        (std::filesystem::temp_directory_path() / "differential_variables").string();
+    int failures;
+    if(argc > 1 && std::string(argv[1]) == "--perf")
+    {
+        if(argc < 3)
+        {
+            std::cerr << "usage: " << argv[0] 
+                << " --perf <baseline_file> [max_regression_percent]\n";
+            return 2;
+        }
+        failures = run_performance(argv[2], argc > 3 ? std::stod(argv[3]) : 20.0, filename);
+    }
+    else
+    {
+        unsigned seed = argc > 1 ? (unsigned)std::stoul(argv[1]) : 0;
+        size_t number_of_inputs = argc > 2 ? std::stoul(argv[2]) : 200;
+        failures = run_differential(seed, number_of_inputs, filename);
+    }
+    std::filesystem::remove(filename);
+    return failures == 0 ? 0 : 1;
+}
+
+#endif
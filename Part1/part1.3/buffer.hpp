@@ -2,6 +2,8 @@
 
 #include<memory>
 
+#include"../../tracing.hpp"
+
 template<class T>
 class temporary_buffer
 {
@@ -17,8 +19,8 @@ private:
 public:
     explicit temporary_buffer(
         size_type initial_size): 
-        m_size(initial_size),
-        m_memory(std::make_unique_for_overwrite<value_type[]>(initial_size))
+        m_memory(std::make_unique_for_overwrite<value_type[]>(initial_size)),
+        m_size(initial_size)
     {}
 
     ~temporary_buffer() = default;
@@ -30,6 +32,7 @@ public:
     
     void increase_by(size_type number_of_elements)
     {
+        TRACE_COUNT(buffer_growths, 1);
         size_type new_size = m_size + number_of_elements;
         auto new_memory = std::make_unique_for_overwrite<value_type[]>(new_size);
         std::copy_n(m_memory.get(), m_size, new_memory.get());
@@ -6,6 +6,7 @@
 #include<regex>
 
 #include"buffer.hpp"
+#include"../../tracing.hpp"
 
 std::regex match_variables(
     "^([A-Za-z_][A-Za-z_0-9()]*)\\s*=\\s*(.*)$", 
@@ -39,12 +40,19 @@ std::map<std::string, std::string> find_all_variables(std::string filename)
                 buffer.size() - number_of_available_chars);
             number_of_available_chars += (size_t)stream.gcount();
         }
+        TRACE_COUNT(bytes_read, number_of_available_chars);
+        TRACE_COUNT(lines_scanned, 1);
                         
         // Test if the line matches the regular expressions and
         // retrieve the name of the variable and the associated value.
         std::match_results<iterator> match;
-        if(std::regex_match(buffer.begin(), buffer.end(), 
-            match, match_variables))
+        bool is_matching;
+        {
+            TRACE_TIME(match_time_ns);
+            is_matching = std::regex_match(buffer.begin(), buffer.end(), 
+                match, match_variables);
+        }
+        if(is_matching)
         {
             variables[match[1].str()] = match[2].str();
         }
@@ -1,12 +1,33 @@
 #pragma once
 
+#include<algorithm>
+#include<cstddef>
+#include<cstdlib>
+#include<cstring>
+#include<limits>
 #include<memory>
+#include<new>
+#include<type_traits>
+#include<utility>
 
+#include"../../tracing.hpp"
+
+// Elements that may be copied as raw bytes and left uninitialized: with
+// the default allocator, the buffer is then managed with malloc, realloc,
+// free and memcpy. Any other type is constructed and destroyed in place.
 template<class T>
+concept trivially_relocatable = std::is_trivial_v<T>
+    && alignof(T) <= alignof(std::max_align_t);
+
+// The memory comes from the allocator when it is not std::allocator, e.g.
+// huge_page_allocator of Part1/part1.9_numa. The allocator is default 
+// constructed when it is needed, so it must be stateless.
+template<class T, class Allocator = std::allocator<T>>
 class temporary_buffer
 {
 public:
     using value_type = T;
+    using allocator_type = Allocator;
     using reference = value_type&;
     using const_reference = const value_type&;
     using pointer = value_type*;
@@ -17,90 +38,218 @@ public:
     using size_type = size_t;
 
 private:
-    std::unique_ptr<value_type[]> m_memory;
+    using allocator_traits = std::allocator_traits<allocator_type>;
+
+    static_assert(allocator_traits::is_always_equal::value, 
+        "the allocator of temporary_buffer must be stateless");
+
+    // With the default allocator, the trivial elements are reallocated in
+    // place when it is possible.
+    static constexpr bool uses_realloc = trivially_relocatable<value_type>
+        && std::is_same_v<allocator_type, std::allocator<value_type>>;
+
+    pointer m_memory;
     size_type m_size;
+
+    static pointer allocate(size_type number_of_elements)
+    {
+        if(number_of_elements == 0)
+            return nullptr;
+        if constexpr(!std::is_same_v<allocator_type, std::allocator<value_type>>)
+        {
+            allocator_type allocator;
+            return allocator_traits::allocate(allocator, number_of_elements);
+        }
+        else if constexpr(uses_realloc)
+        {
+            auto memory = static_cast<pointer>(
+                std::malloc(number_of_elements * sizeof(value_type)));
+            if(memory == nullptr)
+                throw std::bad_alloc();
+            return memory;
+        }
+        else
+            return static_cast<pointer>(::operator new(
+                number_of_elements * sizeof(value_type),
+                std::align_val_t(alignof(value_type))));
+    }
+    static void deallocate(pointer memory, size_type number_of_elements) noexcept
+    {
+        if(memory == nullptr)
+            return;
+        if constexpr(!std::is_same_v<allocator_type, std::allocator<value_type>>)
+        {
+            allocator_type allocator;
+            allocator_traits::deallocate(allocator, memory, number_of_elements);
+        }
+        else if constexpr(uses_realloc)
+            std::free(memory);
+        else
+            ::operator delete(memory, std::align_val_t(alignof(value_type)));
+    }
+
+    // Allocates the memory and default constructs the elements, the
+    // elements of a trivial type are left uninitialized as with
+    // std::make_unique_for_overwrite.
+    static pointer create(size_type number_of_elements)
+    {
+        pointer memory = allocate(number_of_elements);
+        if constexpr(!trivially_relocatable<value_type>)
+        {
+            try
+            {
+                std::uninitialized_default_construct_n(memory, number_of_elements);
+            }
+            catch(...)
+            {
+                deallocate(memory, number_of_elements);
+                throw;
+            }
+        }
+        return memory;
+    }
+    static pointer create_copy(const_pointer source, size_type number_of_elements)
+    {
+        pointer memory = allocate(number_of_elements);
+        if constexpr(trivially_relocatable<value_type>)
+        {
+            if(number_of_elements != 0)
+                std::memcpy(memory, source, number_of_elements * sizeof(value_type));
+        }
+        else
+        {
+            try
+            {
+                std::uninitialized_copy_n(source, number_of_elements, memory);
+            }
+            catch(...)
+            {
+                deallocate(memory, number_of_elements);
+                throw;
+            }
+        }
+        return memory;
+    }
+    static void destroy(pointer memory, size_type number_of_elements) noexcept
+    {
+        if constexpr(!trivially_relocatable<value_type>)
+            std::destroy_n(memory, number_of_elements);
+        deallocate(memory, number_of_elements);
+    }
+
+    // Changes the number of elements, the first elements are preserved.
+    void reallocate(size_type new_size)
+    {
+        if constexpr(uses_realloc)
+        {
+            if(new_size == 0)
+            {
+                std::free(m_memory);
+                m_memory = nullptr;
+            }
+            else
+            {
+                // realloc extends the block in place when it is possible
+                // and otherwise copies the bytes to the new block.
+                auto new_memory = static_cast<pointer>(
+                    std::realloc(m_memory, new_size * sizeof(value_type)));
+                if(new_memory == nullptr)
+                    throw std::bad_alloc();
+                m_memory = new_memory;
+            }
+        }
+        else
+        {
+            pointer new_memory = allocate(new_size);
+            size_type number_of_kept_elements = std::min(m_size, new_size);
+            size_type number_of_constructed_elements = 0;
+            try
+            {
+                std::uninitialized_move_n(m_memory, number_of_kept_elements, new_memory);
+                number_of_constructed_elements = number_of_kept_elements;
+                std::uninitialized_default_construct_n(
+                    new_memory + number_of_kept_elements,
+                    new_size - number_of_kept_elements);
+            }
+            catch(...)
+            {
+                std::destroy_n(new_memory, number_of_constructed_elements);
+                deallocate(new_memory, new_size);
+                throw;
+            }
+            destroy(m_memory, m_size);
+            m_memory = new_memory;
+        }
+        m_size = new_size;
+    }
+
 public:
-    temporary_buffer():
-        temporary_buffer<value_type>(0)
+    temporary_buffer() noexcept:
+        m_memory(nullptr), m_size(0)
         {}
     explicit temporary_buffer(
-        size_type initial_size): 
-        m_size(initial_size),
-        m_memory(std::make_unique_for_overwrite<value_type[]>(initial_size))
+        size_type initial_size):
+        m_memory(create(initial_size)),
+        m_size(initial_size)
     {}
 
-    temporary_buffer(const temporary_buffer<value_type>& another_buffer):
-        m_size(another_buffer.m_size),
-        m_memory(std::make_unique_for_overwrite<value_type[]>(m_size))
-    {
-        std::copy_n(another_buffer.data(), m_size, m_memory.get());
-    }
-    temporary_buffer(temporary_buffer<value_type>&& another_buffer) noexcept:
-        m_size(another_buffer.m_size),
-        m_memory(another_buffer.m_memory)
+    temporary_buffer(const temporary_buffer& another_buffer):
+        m_memory(create_copy(another_buffer.m_memory, another_buffer.m_size)),
+        m_size(another_buffer.m_size)
+    {}
+    temporary_buffer(temporary_buffer&& another_buffer) noexcept:
+        m_memory(std::exchange(another_buffer.m_memory, nullptr)),
+        m_size(std::exchange(another_buffer.m_size, 0))
+    {}
+    ~temporary_buffer()
     {
-        another_buffer.m_size = 0;        
+        destroy(m_memory, m_size);
     }
-    ~temporary_buffer() = default;
-    constexpr temporary_buffer& operator = (const temporary_buffer<value_type>& another_buffer)
+    temporary_buffer& operator = (const temporary_buffer& another_buffer)
     {
         if(&another_buffer != this)
         {
+            pointer new_memory = create_copy(another_buffer.m_memory, another_buffer.m_size);
+            destroy(m_memory, m_size);
+            m_memory = new_memory;
             m_size = another_buffer.m_size;
-            m_memory(std::make_unique_for_overwrite<value_type[]>(another_buffer.m_size)),
-            std::copy_n(another_buffer.data(), m_size, m_memory.get());
         }
         return *this;
     }
-    temporary_buffer& operator = (temporary_buffer<value_type>&& another_buffer) noexcept
+    temporary_buffer& operator = (temporary_buffer&& another_buffer) noexcept
     {
         if(&another_buffer != this)
         {
-            m_size = another_buffer.m_size;
-            m_memory = another_buffer.m_memory;
-            another_buffer.m_size = 0;
+            destroy(m_memory, m_size);
+            m_memory = std::exchange(another_buffer.m_memory, nullptr);
+            m_size = std::exchange(another_buffer.m_size, 0);
         }
         return *this;
     }
 
-    constexpr iterator begin() noexcept { return m_memory.get(); }
-    constexpr const_iterator begin() const noexcept { return m_memory.get(); }
+    constexpr iterator begin() noexcept { return m_memory; }
+    constexpr const_iterator begin() const noexcept { return m_memory; }
 
-    constexpr const_iterator cbegin() const noexcept { return m_memory.get(); }
-    constexpr const_iterator cend() const noexcept { return m_memory.get()  + m_size; }
+    constexpr const_iterator cbegin() const noexcept { return m_memory; }
+    constexpr const_iterator cend() const noexcept { return m_memory + m_size; }
+
+    constexpr iterator end() noexcept { return m_memory + m_size; }
+    constexpr const_iterator end() const noexcept { return m_memory + m_size; }
 
-    constexpr iterator end() { return m_memory.get() + m_size; }
-    constexpr const_iterator end() const noexcept { return m_memory.get()  + m_size; }
-    
     constexpr bool empty() const noexcept { return m_size == 0; }
 
     void increase_by(size_type number_of_elements)
     {
-        size_type new_size = m_size + number_of_elements;
-        auto new_memory = std::make_unique_for_overwrite<value_type[]>(new_size);
-        std::copy_n(m_memory.get(), m_size, new_memory.get());
-        m_size = new_size;
-        std::swap(m_memory, new_memory);
+        TRACE_COUNT(buffer_growths, 1);
+        reallocate(m_size + number_of_elements);
     }
 
-    constexpr pointer data() noexcept { return m_memory.get(); }
-    constexpr const_pointer data() const noexcept { return m_memory.get(); }
+    constexpr pointer data() noexcept { return m_memory; }
+    constexpr const_pointer data() const noexcept { return m_memory; }
 
     void decrease_by(size_type number_of_elements)
     {
-        if(number_of_elements > m_size)
-        {
-            m_size = 0;
-            m_memory = std::make_unique_for_overwrite<value_type[]>(m_size);
-        }
-        else
-        {
-            size_type new_size = m_size - number_of_elements;
-            auto new_memory = std::make_unique_for_overwrite<value_type[]>(new_size);
-            std::copy_n(m_memory.get(), new_size, new_memory.get());
-            m_size = new_size;
-            std::swap(m_memory, new_memory);
-        }
+        reallocate(number_of_elements > m_size ? 0 : m_size - number_of_elements);
     }
 
     constexpr size_type max_size() const noexcept { return std::numeric_limits<unsigned>::max(); }
@@ -108,19 +257,17 @@ public:
 
     void resize(size_type number_of_elements)
     {
-        if(number_of_elements < m_size)
-            decrease_by(m_size - number_of_elements)
-        else
-            increase_by(number_of_elements - m_size);
+        if(number_of_elements != m_size)
+            reallocate(number_of_elements);
     }
 
-    constexpr void swap(temporary_buffer<value_type>& another_buffer) noexcept
+    constexpr void swap(temporary_buffer& another_buffer) noexcept
     {
         std::swap(m_memory, another_buffer.m_memory);
         std::swap(m_size, another_buffer.m_size);
     }
 
-    constexpr bool operator == (const temporary_buffer<value_type>& another_buffer) const noexcept
+    constexpr bool operator == (const temporary_buffer& another_buffer) const noexcept
     {
         return m_memory == another_buffer.m_memory;
     }
@@ -129,10 +276,11 @@ public:
 namespace std
 {
 
-template<class T>
-constexpr void swap(temporary_buffer<T>& first_buffer, temporary_buffer<T>& second_buffer)
+template<class T, class Allocator>
+constexpr void swap(temporary_buffer<T, Allocator>& first_buffer, 
+    temporary_buffer<T, Allocator>& second_buffer)
 {
     first_buffer.swap(second_buffer);
 }
 
-}
\ No newline at end of file
+}
@@ -4,8 +4,10 @@
 #include<iterator>
 #include<map>
 #include<regex>
+#include<string>
 
 #include"buffer.hpp"
+#include"../variables_format.hpp"
 
 std::regex match_variables(
     "^([A-Za-z_][A-Za-z_0-9()]*)\\s*=\\s*(.*)$", 
@@ -40,10 +42,16 @@ std::map<std::string, std::string> find_all_variables(std::string filename)
             number_of_available_chars += (size_t)stream.gcount();
         }
                         
+        // Only consider the characters of the line, getline ends them
+        // with a null character.
+        iterator end_of_line = std::find(buffer.begin(), buffer.end(), '\0');
+        if((size_t)(end_of_line - buffer.begin()) > max_line_length)
+            continue;
+
         // Test if the line matches the regular expressions and
         // retrieve the name of the variable and the associated value.
         std::match_results<iterator> match;
-        if(std::regex_match(buffer.begin(), buffer.end(), 
+        if(std::regex_match(buffer.begin(), end_of_line, 
             match, match_variables))
         {
             variables[match[1].str()] = match[2].str();
@@ -57,4 +65,34 @@ int main()
 {
     auto variables = find_all_variables("C:\\Temp\\variables");
     std::cout << "Number of variables: " << variables.size() << "\n";
+
+    // The strings are constructed, moved and destroyed in place when the 
+    // buffer grows, shrinks or is copied.
+    temporary_buffer<std::string> strings(2);
+    strings.data()[0] = "first";
+    strings.data()[1] = std::string(100, 's');
+    strings.increase_by(3);
+    strings.data()[4] = "last";
+    strings.decrease_by(1);
+    temporary_buffer<std::string> copy(strings);
+    temporary_buffer<std::string> moved(std::move(strings));
+    bool is_valid = strings.empty() && strings.data() == nullptr
+        && copy.size() == 4 && moved.size() == 4 && copy.data() != moved.data()
+        && std::equal(copy.begin(), copy.end(), moved.begin())
+        && moved.data()[0] == "first" && moved.data()[1] == std::string(100, 's')
+        && moved.data()[2].empty() && moved.data()[3].empty();
+    copy = std::move(moved);
+    is_valid = is_valid && moved.empty() && copy.size() == 4;
+
+    // The characters are moved with the memory that holds them.
+    temporary_buffer<char> characters(16);
+    std::fill(characters.begin(), characters.end(), 'c');
+    char* memory = characters.data();
+    temporary_buffer<char> moved_characters(std::move(characters));
+    is_valid = is_valid && characters.empty() && characters.data() == nullptr
+        && moved_characters.data() == memory && moved_characters.size() == 16
+        && std::count(moved_characters.begin(), moved_characters.end(), 'c') == 16;
+
+    std::cout << "Buffers: " << (is_valid ? "valid" : "invalid") << "\n";
+    return is_valid ? 0 : 1;
 }
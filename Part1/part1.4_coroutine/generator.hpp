@@ -0,0 +1,117 @@
+#pragma once
+
+#include<coroutine>
+#include<exception>
+#include<iterator>
+#include<optional>
+#include<utility>
+
+// Minimal replacement for std::generator (C++23): a coroutine returning
+// generator<T> may co_yield values of type T, the consumer iterates over
+// them with a range-based for loop. The coroutine is resumed each time
+// the iterator is incremented, hence the values are computed lazily.
+template<class T>
+class generator
+{
+public:
+    using value_type = T;
+    using reference = value_type&;
+    using pointer = value_type*;
+
+    struct promise_type
+    {
+        std::optional<value_type> m_value;
+        std::exception_ptr m_exception;
+
+        generator get_return_object() 
+        { 
+            return generator(handle_type::from_promise(*this)); 
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(value_type aValue)
+        {
+            m_value = std::move(aValue);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { m_exception = std::current_exception(); }
+        template<class U>
+        std::suspend_never await_transform(U&&) = delete;
+    };
+
+private:
+    using handle_type = std::coroutine_handle<promise_type>;
+    handle_type m_coroutine;
+
+    explicit generator(handle_type theCoroutine): 
+        m_coroutine(theCoroutine) 
+        {}
+
+public:
+    class iterator
+    {
+    private:
+        handle_type m_coroutine;
+
+        void resume()
+        {
+            m_coroutine.resume();
+            if(m_coroutine.done() && m_coroutine.promise().m_exception)
+                std::rethrow_exception(m_coroutine.promise().m_exception);
+        }
+
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = typename generator<T>::value_type;
+        using pointer = typename generator<T>::pointer;
+        using reference = typename generator<T>::reference;
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::input_iterator_tag;
+
+        iterator(): m_coroutine() {}
+        explicit iterator(handle_type theCoroutine): 
+            m_coroutine(theCoroutine)
+        {
+            resume();
+        }
+        iterator& operator++()
+        {
+            resume();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        reference operator *() const { return *m_coroutine.promise().m_value; }
+        pointer operator ->() const { return &*m_coroutine.promise().m_value; }
+        bool operator == (std::default_sentinel_t) const 
+        { 
+            return !m_coroutine || m_coroutine.done(); 
+        }
+    };
+
+    generator(const generator&) = delete;
+    generator(generator&& another_generator) noexcept:
+        m_coroutine(std::exchange(another_generator.m_coroutine, {}))
+        {}
+    ~generator()
+    {
+        if(m_coroutine)
+            m_coroutine.destroy();
+    }
+    generator& operator = (const generator&) = delete;
+    generator& operator = (generator&& another_generator) noexcept
+    {
+        if(&another_generator != this)
+        {
+            if(m_coroutine)
+                m_coroutine.destroy();
+            m_coroutine = std::exchange(another_generator.m_coroutine, {});
+        }
+        return *this;
+    }
+
+    // The coroutine may only be started once: begin() must be called
+    // a single time.
+    iterator begin() { return iterator(m_coroutine); }
+    std::default_sentinel_t end() const noexcept { return {}; }
+};
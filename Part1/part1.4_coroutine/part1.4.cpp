@@ -0,0 +1,232 @@
+#include<algorithm>
+#include<condition_variable>
+#include<fstream>
+#include<iostream>
+#include<iterator>
+#include<limits>
+#include<mutex>
+#include<regex>
+#include<stop_token>
+#include<string>
+#include<thread>
+#include<utility>
+
+#include"../part1.3_containeur/buffer.hpp"
+#include"generator.hpp"
+#include"../variables_format.hpp"
+#include"../../tracing.hpp"
+
+std::regex match_variables(
+    "^([A-Za-z_][A-Za-z_0-9()]*)\\s*=\\s*(.*)$", 
+    std::regex_constants::ECMAScript);
+
+using variable = std::pair<std::string, std::string>;
+
+// Yields the variables one after the other while the file is read line
+// by line. Only the current line is kept in memory.
+generator<variable> variables_in(std::string filename)
+{
+    using buffer_type = temporary_buffer<char>;
+    using iterator = typename buffer_type::iterator;
+
+    const size_t buffer_size = 80;
+    const size_t increment = 40;
+
+    buffer_type buffer(buffer_size);
+    std::ifstream stream(filename);
+
+    while(!stream.eof() && !stream.fail())
+    {
+        // Try to load the full line into the buffer.
+        stream.getline(buffer.data(), buffer.size());
+        size_t number_of_available_chars = (size_t)stream.gcount();
+        bool is_too_long = false;
+        while(stream.fail() && !stream.eof() 
+            && number_of_available_chars == buffer.size() - 1)
+        {
+            if(number_of_available_chars > max_line_length)
+            {
+                // Drop the end of the line without loading it in memory.
+                stream.clear();
+                stream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                number_of_available_chars += (size_t)stream.gcount();
+                is_too_long = true;
+                break;
+            }
+            // Increase the buffer as long as it is required.
+            buffer.increase_by(increment);
+            stream.clear();
+            stream.getline(
+                buffer.data() + number_of_available_chars, 
+                buffer.size() - number_of_available_chars);
+            number_of_available_chars += (size_t)stream.gcount();
+        }
+        TRACE_COUNT(bytes_read, number_of_available_chars);
+        TRACE_COUNT(lines_scanned, 1);
+        if(is_too_long)
+            continue;
+
+        // Only consider the characters of the line, getline ends them
+        // with a null character.
+        iterator end_of_line = std::find(buffer.begin(), buffer.end(), '\0');
+        if((size_t)(end_of_line - buffer.begin()) > max_line_length)
+            continue;
+        std::match_results<iterator> match;
+        bool is_matching;
+        {
+            TRACE_TIME(match_time_ns);
+            is_matching = std::regex_match(buffer.begin(), end_of_line, 
+                match, match_variables);
+        }
+        if(is_matching)
+        {
+            co_yield variable(match[1].str(), match[2].str());
+        }
+    }
+}
+
+// Tests if the characters in [start_of_line, end_of_line) define a 
+// variable and stores its name and its value in result.
+bool match_variable(const char* start_of_line, const char* end_of_line, 
+    variable& result)
+{
+    TRACE_COUNT(lines_scanned, 1);
+    if((size_t)(end_of_line - start_of_line) > max_line_length)
+        return false;
+    std::match_results<const char*> match;
+    bool is_matching;
+    {
+        TRACE_TIME(match_time_ns);
+        is_matching = std::regex_match(start_of_line, end_of_line, match, match_variables);
+    }
+    if(!is_matching)
+        return false;
+    result = variable(match[1].str(), match[2].str());
+    return true;
+}
+
+// Same as variables_in but the file is read by blocks in a background 
+// thread. While a block is parsed, the next one is loaded into the second
+// buffer, so disk reads overlap with the matching of the lines.
+generator<variable> async_variables_in(std::string filename)
+{
+    using buffer_type = temporary_buffer<char>;
+    using iterator = typename buffer_type::iterator;
+
+    const size_t block_size = 64 * 1024;
+
+    std::ifstream stream(filename, std::ios::binary);
+    buffer_type blocks[2] = { buffer_type(block_size), buffer_type(block_size) };
+
+    // The reader fills the blocks alternately: it waits until the parser 
+    // releases a block before loading the next part of the file into it.
+    // An empty block marks the end of the file.
+    std::mutex mutex;
+    std::condition_variable_any is_changed;
+    bool is_filled[2] = { false, false };
+    size_t block_lengths[2] = { 0, 0 };
+
+    // The reader is declared after the state it uses: it is destroyed 
+    // first, and is stopped and joined if the consumer stops iterating 
+    // before the end of the file.
+    std::jthread reader([&](std::stop_token stop)
+    {
+        for(size_t current = 0; ; current = 1 - current)
+        {
+            {
+                std::unique_lock lock(mutex);
+                if(!is_changed.wait(lock, stop, [&] { return !is_filled[current]; }))
+                    return;
+            }
+            stream.read(blocks[current].data(), (std::streamsize)blocks[current].size());
+            size_t length = (size_t)stream.gcount();
+            {
+                std::lock_guard lock(mutex);
+                block_lengths[current] = length;
+                is_filled[current] = true;
+            }
+            is_changed.notify_all();
+            if(length == 0)
+                return;
+        }
+    });
+
+    // Part of a line that spans over two blocks. A line longer than 
+    // max_line_length is dropped as soon as it is known to be too long.
+    std::string pending_line;
+    bool is_too_long = false;
+    auto append_pending = [&](iterator first, iterator last)
+    {
+        if(is_too_long)
+            return;
+        if(pending_line.size() + (size_t)(last - first) > max_line_length)
+        {
+            is_too_long = true;
+            pending_line.clear();
+            return;
+        }
+        pending_line.append(first, last);
+    };
+
+    variable result;
+    for(size_t current = 0; ; current = 1 - current)
+    {
+        size_t number_of_available_chars;
+        {
+            std::unique_lock lock(mutex);
+            is_changed.wait(lock, [&] { return is_filled[current]; });
+            number_of_available_chars = block_lengths[current];
+        }
+        if(number_of_available_chars == 0)
+            break;
+        TRACE_COUNT(bytes_read, number_of_available_chars);
+
+        iterator start_of_line = blocks[current].begin();
+        iterator end_of_block = start_of_line + number_of_available_chars;
+        for(iterator end_of_line = std::find(start_of_line, end_of_block, '\n');
+            end_of_line != end_of_block;
+            end_of_line = std::find(start_of_line, end_of_block, '\n'))
+        {
+            if(is_too_long)
+            {
+                TRACE_COUNT(lines_scanned, 1);
+                is_too_long = false;
+            }
+            else if(!pending_line.empty())
+            {
+                append_pending(start_of_line, end_of_line);
+                if(!is_too_long && match_variable(pending_line.data(), 
+                    pending_line.data() + pending_line.size(), result))
+                    co_yield std::move(result);
+                is_too_long = false;
+                pending_line.clear();
+            }
+            else if(match_variable(start_of_line, end_of_line, result))
+                co_yield std::move(result);
+            start_of_line = end_of_line + 1;
+        }
+        append_pending(start_of_line, end_of_block);
+
+        {
+            std::lock_guard lock(mutex);
+            is_filled[current] = false;
+        }
+        is_changed.notify_all();
+    }
+    if(!is_too_long && match_variable(pending_line.data(), 
+        pending_line.data() + pending_line.size(), result))
+        co_yield std::move(result);
+}
+
+int main()
+{
+    size_t number_of_variables = 0;
+    for([[maybe_unused]] auto& [name, value]: variables_in("C:\\Temp\\variables"))
+        number_of_variables ++;
+    std::cout << "Number of variables: " << number_of_variables << "\n";
+
+    number_of_variables = 0;
+    for([[maybe_unused]] auto& [name, value]: async_variables_in("C:\\Temp\\variables"))
+        number_of_variables ++;
+    std::cout << "Number of variables (async): " << number_of_variables << "\n";
+}
@@ -0,0 +1,174 @@
+#include<algorithm>
+#include<chrono>
+#include<exception>
+#include<fstream>
+#include<iostream>
+#include<iterator>
+#include<map>
+#include<regex>
+#include<stdexcept>
+#include<string>
+#include<vector>
+
+#include"../part1.3_containeur/buffer.hpp"
+#include"thread_pool.hpp"
+#include"../part1.9_numa/numa_allocator.hpp"
+#include"../variables_format.hpp"
+#include"../../tracing.hpp"
+
+const std::regex match_variables(
+    "^([A-Za-z_][A-Za-z_0-9()]*)\\s*=\\s*(.*)$", 
+    std::regex_constants::ECMAScript);
+
+// Parser owned by a worker of the pool. The line buffer and the regular 
+// expression are created once and reused for all the files that are 
+// parsed by the worker.
+class variables_parser
+{
+public:
+    using buffer_type = temporary_buffer<char>;
+    using iterator = typename buffer_type::iterator;
+
+private:
+    static const size_t buffer_size = 80;
+    static const size_t increment = 40;
+
+    buffer_type m_buffer;
+    std::regex m_match_variables;
+
+public:
+    variables_parser(): 
+        m_buffer(buffer_size), m_match_variables(match_variables) 
+        {}
+
+    std::map<std::string, std::string> find_all_variables(const std::string& filename)
+    {
+        std::map<std::string, std::string> variables;
+        std::ifstream stream(filename);
+        if(!stream)
+            throw std::runtime_error("cannot open " + filename);
+
+        while(!stream.eof() && !stream.fail())
+        {
+            // Try to load the full line into the buffer.
+            stream.getline(m_buffer.data(), m_buffer.size());
+            size_t number_of_available_chars = (size_t)stream.gcount();
+            while(stream.fail() && !stream.eof() 
+                && number_of_available_chars == m_buffer.size() - 1)
+            {
+                // Increase the buffer as long as it is required, the 
+                // larger buffer is kept for the next files.
+                m_buffer.increase_by(increment);
+                stream.clear();
+                stream.getline(
+                    m_buffer.data() + number_of_available_chars, 
+                    m_buffer.size() - number_of_available_chars);
+                number_of_available_chars += (size_t)stream.gcount();
+            }
+            TRACE_COUNT(bytes_read, number_of_available_chars);
+            TRACE_COUNT(lines_scanned, 1);
+
+            iterator end_of_line = std::find(m_buffer.begin(), m_buffer.end(), '\0');
+            if((size_t)(end_of_line - m_buffer.begin()) > max_line_length)
+                continue;
+            std::match_results<iterator> match;
+            bool is_matching;
+            {
+                TRACE_TIME(match_time_ns);
+                is_matching = std::regex_match(m_buffer.begin(), end_of_line, 
+                    match, m_match_variables);
+            }
+            if(is_matching)
+            {
+                variables[match[1].str()] = match[2].str();
+            }
+        }
+        return variables;
+    }
+};
+
+struct file_statistics
+{
+    std::chrono::steady_clock::duration parsing_time;
+    size_t worker_index;
+    std::exception_ptr error;
+};
+
+struct file_variables
+{
+    std::map<std::string, std::string> variables;
+    file_statistics statistics;
+};
+
+// Parses all the files on the workers of the pool and returns the 
+// variables and the statistics of each file indexed by the name of the 
+// file.
+std::map<std::string, file_variables> find_all_variables(
+    const std::vector<std::string>& filenames, thread_pool& pool)
+{
+    std::vector<variables_parser> parsers(pool.size());
+    std::vector<file_variables> results(filenames.size());
+
+    for(size_t index = 0; index < filenames.size(); index ++)
+    {
+        pool.submit([&, index](size_t worker_index)
+        {
+            auto& result = results[index];
+            auto start = std::chrono::steady_clock::now();
+            try
+            {
+                result.variables = 
+                    parsers[worker_index].find_all_variables(filenames[index]);
+            }
+            catch(...)
+            {
+                result.statistics.error = std::current_exception();
+            }
+            result.statistics.parsing_time = 
+                std::chrono::steady_clock::now() - start;
+            result.statistics.worker_index = worker_index;
+        });
+    }
+    pool.wait();
+
+    std::map<std::string, file_variables> variables_by_file;
+    for(size_t index = 0; index < filenames.size(); index ++)
+        variables_by_file[filenames[index]] = std::move(results[index]);
+    return variables_by_file;
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> filenames(argv + 1, argv + argc);
+    if(filenames.empty())
+        filenames.push_back("C:\\Temp\\variables");
+
+    // The workers are spread over the NUMA nodes and each one stays on
+    // its node, so that the lines it reads remain in the memory of this
+    // node.
+    int number_of_nodes = numa::number_of_nodes();
+    thread_pool pool(std::thread::hardware_concurrency(), 
+        [number_of_nodes](size_t worker_index) 
+        { numa::pin_current_thread((int)(worker_index % (size_t)number_of_nodes)); });
+    auto variables_by_file = find_all_variables(filenames, pool);
+    for(auto& [filename, result]: variables_by_file)
+    {
+        if(result.statistics.error)
+        {
+            try
+            {
+                std::rethrow_exception(result.statistics.error);
+            }
+            catch(const std::exception& error)
+            {
+                std::cout << filename << ": " << error.what() << "\n";
+            }
+            continue;
+        }
+        std::cout << filename << ": " 
+            << result.variables.size() << " variables in "
+            << std::chrono::duration_cast<std::chrono::microseconds>(
+                result.statistics.parsing_time).count() << "us (worker "
+            << result.statistics.worker_index << ")\n";
+    }
+}
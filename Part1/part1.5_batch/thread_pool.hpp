@@ -0,0 +1,150 @@
+#pragma once
+
+#include<atomic>
+#include<condition_variable>
+#include<deque>
+#include<functional>
+#include<memory>
+#include<mutex>
+#include<thread>
+#include<vector>
+
+// Pool of threads where each worker owns a queue of tasks. A worker takes
+// its tasks from the back of its own queue and, when its queue is empty,
+// steals the tasks from the front of the queues of the other workers.
+// Each task receives the index of the worker that executes it, so that 
+// the tasks can reuse resources allocated once per worker.
+class thread_pool
+{
+public:
+    using task_type = std::function<void(size_t)>;
+    // Called by each worker with its index before it executes any task,
+    // e.g. to pin the worker to a processor.
+    using initializer_type = std::function<void(size_t)>;
+    using size_type = size_t;
+
+private:
+    struct worker_queue
+    {
+        std::mutex m_mutex;
+        std::deque<task_type> m_tasks;
+    };
+
+    std::vector<std::unique_ptr<worker_queue>> m_queues;
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_task_available;
+    std::condition_variable m_all_tasks_done;
+    size_type m_queued_tasks;
+    size_type m_pending_tasks;
+    bool m_is_stopping;
+    std::atomic<size_type> m_next_queue;
+
+    bool pop_own_task(size_type worker_index, task_type& task)
+    {
+        auto& queue = *m_queues[worker_index];
+        std::lock_guard<std::mutex> lock(queue.m_mutex);
+        if(queue.m_tasks.empty())
+            return false;
+        task = std::move(queue.m_tasks.back());
+        queue.m_tasks.pop_back();
+        return true;
+    }
+    bool steal_task(size_type worker_index, task_type& task)
+    {
+        for(size_type offset = 1; offset < m_queues.size(); offset ++)
+        {
+            auto& queue = *m_queues[(worker_index + offset) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            if(!queue.m_tasks.empty())
+            {
+                task = std::move(queue.m_tasks.front());
+                queue.m_tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+    void run(size_type worker_index, initializer_type initializer)
+    {
+        if(initializer)
+            initializer(worker_index);
+        task_type task;
+        while(true)
+        {
+            if(pop_own_task(worker_index, task) || steal_task(worker_index, task))
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_queued_tasks --;
+                }
+                task(worker_index);
+                task = nullptr;
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if(-- m_pending_tasks == 0)
+                    m_all_tasks_done.notify_all();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_task_available.wait(lock, 
+                [this]() { return m_is_stopping || m_queued_tasks != 0; });
+            if(m_is_stopping && m_queued_tasks == 0)
+                return;
+        }
+    }
+
+public:
+    explicit thread_pool(
+        size_type number_of_workers = std::thread::hardware_concurrency(),
+        initializer_type initializer = nullptr):
+        m_queued_tasks(0), m_pending_tasks(0), 
+        m_is_stopping(false), m_next_queue(0)
+    {
+        if(number_of_workers == 0)
+            number_of_workers = 1;
+        for(size_type index = 0; index < number_of_workers; index ++)
+            m_queues.push_back(std::make_unique<worker_queue>());
+        for(size_type index = 0; index < number_of_workers; index ++)
+            m_workers.emplace_back(&thread_pool::run, this, index, initializer);
+    }
+    thread_pool(const thread_pool&) = delete;
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_is_stopping = true;
+        }
+        m_task_available.notify_all();
+        for(auto& worker: m_workers)
+            worker.join();
+    }
+    thread_pool& operator = (const thread_pool&) = delete;
+
+    size_type size() const noexcept { return m_workers.size(); }
+
+    // Adds the task to the queues of the workers in a round robin way,
+    // an idle worker will steal it if its owner is busy.
+    void submit(task_type task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queued_tasks ++;
+            m_pending_tasks ++;
+        }
+        auto& queue = *m_queues[m_next_queue++ % m_queues.size()];
+        {
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            queue.m_tasks.push_back(std::move(task));
+        }
+        m_task_available.notify_one();
+    }
+
+    // Blocks until all the tasks that have been submitted are executed.
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_all_tasks_done.wait(lock, [this]() { return m_pending_tasks == 0; });
+    }
+};
@@ -0,0 +1,92 @@
+#include<algorithm>
+#include<fstream>
+#include<iostream>
+#include<iterator>
+#include<map>
+#include<regex>
+#include<string_view>
+
+#include"../part1.3_containeur/buffer.hpp"
+#include"value.hpp"
+#include"../variables_format.hpp"
+#include"../../tracing.hpp"
+
+std::regex match_variables(
+    "^([A-Za-z_][A-Za-z_0-9()]*)\\s*=\\s*(.*)$", 
+    std::regex_constants::ECMAScript);
+
+std::map<std::string, typed_value> find_all_variables(std::string filename)
+{
+    using buffer_type = temporary_buffer<char>;
+    using iterator = typename buffer_type::iterator;
+
+    const size_t buffer_size = 80;
+    const size_t increment = 40;
+
+    buffer_type buffer(buffer_size) ;
+    std::map<std::string, typed_value> variables;
+    std::ifstream stream(filename);
+
+    while(!stream.eof() && !stream.fail())
+    {
+        // Try to load the full line into the buffer.
+        stream.getline(buffer.data(), buffer.size());
+        size_t number_of_available_chars = (size_t)stream.gcount();
+        while(stream.fail() && !stream.eof() 
+            && number_of_available_chars == buffer.size() - 1)
+        {
+            // Increase the buffer as long as it is required.
+            buffer.increase_by(increment);
+            stream.clear();
+            stream.getline(
+                buffer.data() + number_of_available_chars, 
+                buffer.size() - number_of_available_chars);
+            number_of_available_chars += (size_t)stream.gcount();
+        }
+        TRACE_COUNT(bytes_read, number_of_available_chars);
+        TRACE_COUNT(lines_scanned, 1);
+                        
+        // Test if the line matches the regular expressions and convert
+        // the value while it is still in the buffer.
+        iterator end_of_line = std::find(buffer.begin(), buffer.end(), '\0');
+        if((size_t)(end_of_line - buffer.begin()) > max_line_length)
+            continue;
+        std::match_results<iterator> match;
+        bool is_matching;
+        {
+            TRACE_TIME(match_time_ns);
+            is_matching = std::regex_match(buffer.begin(), end_of_line, 
+                match, match_variables);
+        }
+        if(is_matching)
+        {
+            variables[match[1].str()] = parse_value(
+                std::string_view(match[2].first, (size_t)match[2].length()));
+        }
+    }
+    return variables;
+}
+
+
+int main()
+{
+    auto variables = find_all_variables("C:\\Temp\\variables");
+    std::cout << "Number of variables: " << variables.size() << "\n";
+
+    size_t number_of_integers = 0;
+    size_t number_of_floatings = 0;
+    size_t number_of_booleans = 0;
+    for(auto& [name, value]: variables)
+    {
+        switch(value.type())
+        {
+        case typed_value::kind::integer: number_of_integers ++; break;
+        case typed_value::kind::floating: number_of_floatings ++; break;
+        case typed_value::kind::boolean: number_of_booleans ++; break;
+        default: break;
+        }
+    }
+    std::cout << "Integers: " << number_of_integers 
+        << ", floating point numbers: " << number_of_floatings
+        << ", booleans: " << number_of_booleans << "\n";
+}
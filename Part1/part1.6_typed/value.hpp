@@ -0,0 +1,94 @@
+#pragma once
+
+#include<charconv>
+#include<concepts>
+#include<string>
+#include<string_view>
+#include<system_error>
+#include<variant>
+
+// Value of a variable converted once when the file is parsed. The value
+// is stored in a tagged union, the accessors return the converted value
+// without any further parsing.
+class typed_value
+{
+public:
+    using integer_type = long long;
+    using floating_type = double;
+    using boolean_type = bool;
+    using string_type = std::string;
+
+    enum class kind { integer, floating, boolean, string };
+
+private:
+    std::variant<integer_type, floating_type, boolean_type, string_type> m_value;
+
+public:
+    typed_value(): m_value(string_type()) {}
+    // The arithmetic constructors are templates so that any integer is
+    // stored as an integer and that a pointer is never converted to a
+    // boolean.
+    template<std::integral T> requires (!std::same_as<T, boolean_type>)
+    typed_value(T aValue): m_value(static_cast<integer_type>(aValue)) {}
+    template<std::floating_point T>
+    typed_value(T aValue): m_value(static_cast<floating_type>(aValue)) {}
+    template<std::same_as<boolean_type> T>
+    typed_value(T aValue): m_value(aValue) {}
+    typed_value(string_type aValue): m_value(std::move(aValue)) {}
+    typed_value(std::string_view aValue): m_value(string_type(aValue)) {}
+    typed_value(const char* aValue): m_value(string_type(aValue)) {}
+
+    constexpr kind type() const noexcept { return static_cast<kind>(m_value.index()); }
+
+    template<class T>
+    constexpr bool holds() const noexcept { return std::holds_alternative<T>(m_value); }
+
+    // Throws std::bad_variant_access if the value is not of type T.
+    template<class T>
+    constexpr const T& get() const { return std::get<T>(m_value); }
+
+    // Returns nullptr if the value is not of type T.
+    template<class T>
+    constexpr const T* get_if() const noexcept { return std::get_if<T>(&m_value); }
+
+    constexpr integer_type as_integer() const { return get<integer_type>(); }
+    constexpr floating_type as_floating() const { return get<floating_type>(); }
+    constexpr boolean_type as_boolean() const { return get<boolean_type>(); }
+    constexpr const string_type& as_string() const { return get<string_type>(); }
+};
+
+// Recognizes the integers, the floating point numbers, the booleans 
+// (true or false) and the quoted strings. Any other text is kept as a
+// string, as well as the numbers out of range and the words accepted by
+// std::from_chars such as nan or inf.
+inline typed_value parse_value(std::string_view text)
+{
+    if(text == "true")
+        return typed_value(true);
+    if(text == "false")
+        return typed_value(false);
+    if(text.size() >= 2 && text.front() == '"' && text.back() == '"')
+        return typed_value(std::string(text.substr(1, text.size() - 2)));
+
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    if(first != last)
+    {
+        typed_value::integer_type integer_value;
+        auto [end_of_integer, integer_error] = std::from_chars(first, last, integer_value);
+        if(integer_error == std::errc() && end_of_integer == last)
+            return typed_value(integer_value);
+        if(integer_error == std::errc::result_out_of_range)
+            return typed_value(std::string(text));
+
+        const char* first_digit = *first == '-' ? first + 1 : first;
+        if(first_digit == last || *first_digit < '0' || *first_digit > '9')
+            return typed_value(std::string(text));
+
+        typed_value::floating_type floating_value;
+        auto [end_of_floating, floating_error] = std::from_chars(first, last, floating_value);
+        if(floating_error == std::errc() && end_of_floating == last)
+            return typed_value(floating_value);
+    }
+    return typed_value(std::string(text));
+}
@@ -0,0 +1,164 @@
+#include<algorithm>
+#include<fstream>
+#include<iostream>
+#include<iterator>
+#include<limits>
+#include<map>
+#include<regex>
+#include<stdexcept>
+
+#include"../part1.3_containeur/buffer.hpp"
+#include"../variables_format.hpp"
+#include"../../tracing.hpp"
+
+std::regex match_variables(
+    "^([A-Za-z_][A-Za-z_0-9()]*)\\s*=\\s*(.*)$", 
+    std::regex_constants::ECMAScript);
+
+// What to do when a line is longer than the maximal length or when the
+// variables do not fit in the memory budget.
+enum class overflow_policy
+{
+    skip,       // the line is ignored.
+    truncate,   // only the first characters of the line are considered.
+    error       // a std::length_error exception is thrown.
+};
+
+struct reading_limits
+{
+    size_t max_line_length = ::max_line_length;
+    // Bytes used by the line buffer and the names and values of the 
+    // variables.
+    size_t memory_budget = 1024 * 1024;
+    overflow_policy policy = overflow_policy::skip;
+};
+
+struct reading_report
+{
+    size_t skipped_bytes = 0;
+    size_t skipped_lines = 0;
+    size_t truncated_lines = 0;
+};
+
+std::map<std::string, std::string> find_all_variables(std::string filename, 
+    const reading_limits& limits, reading_report& report)
+{
+    using buffer_type = temporary_buffer<char>;
+    using iterator = typename buffer_type::iterator;
+
+    const size_t buffer_size = 80;
+    const size_t increment = 40;
+
+    // The buffer holds at most max_line_length characters followed by the
+    // null character added by getline.
+    buffer_type buffer(std::min(buffer_size, limits.max_line_length + 1));
+    std::map<std::string, std::string> variables;
+    size_t used_memory = buffer.size();
+    std::ifstream stream(filename);
+
+    while(!stream.eof() && !stream.fail())
+    {
+        // Try to load the full line into the buffer.
+        stream.getline(buffer.data(), buffer.size());
+        size_t number_of_available_chars = (size_t)stream.gcount();
+        bool is_too_long = false;
+        while(stream.fail() && !stream.eof() 
+            && number_of_available_chars == buffer.size() - 1)
+        {
+            if(buffer.size() > limits.max_line_length)
+            {
+                is_too_long = true;
+                break;
+            }
+            // Increase the buffer as long as it is required and allowed,
+            // a line that does not fit in the memory budget is handled as
+            // a line longer than the maximal length.
+            size_t number_of_elements = std::min(increment, 
+                limits.max_line_length + 1 - buffer.size());
+            if(used_memory + number_of_elements > limits.memory_budget)
+            {
+                if(limits.policy == overflow_policy::error)
+                    throw std::length_error("line exceeds the memory budget");
+                is_too_long = true;
+                break;
+            }
+            buffer.increase_by(number_of_elements);
+            used_memory += number_of_elements;
+            stream.clear();
+            stream.getline(
+                buffer.data() + number_of_available_chars, 
+                buffer.size() - number_of_available_chars);
+            number_of_available_chars += (size_t)stream.gcount();
+        }
+        TRACE_COUNT(bytes_read, number_of_available_chars);
+        TRACE_COUNT(lines_scanned, 1);
+
+        if(is_too_long)
+        {
+            if(limits.policy == overflow_policy::error)
+                throw std::length_error("line exceeds the maximal line length");
+
+            // Drop the end of the line without loading it in memory.
+            stream.clear();
+            stream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            // The end of line character is not part of the skipped bytes.
+            size_t number_of_ignored_chars = (size_t)stream.gcount();
+            if(!stream.eof() && number_of_ignored_chars > 0)
+                number_of_ignored_chars --;
+            TRACE_COUNT(bytes_read, number_of_ignored_chars);
+            report.skipped_bytes += number_of_ignored_chars;
+            if(limits.policy == overflow_policy::skip)
+            {
+                report.skipped_bytes += number_of_available_chars;
+                report.skipped_lines ++;
+                continue;
+            }
+            report.truncated_lines ++;
+        }
+
+        // Test if the line matches the regular expressions and
+        // retrieve the name of the variable and the associated value.
+        iterator end_of_line = std::find(buffer.begin(), buffer.end(), '\0');
+        std::match_results<iterator> match;
+        bool is_matching;
+        {
+            TRACE_TIME(match_time_ns);
+            is_matching = std::regex_match(buffer.begin(), end_of_line, 
+                match, match_variables);
+        }
+        if(is_matching)
+        {
+            auto name = match[1].str();
+            auto existing_variable = variables.find(name);
+            size_t released_memory = existing_variable == variables.end() ? 0
+                : existing_variable->first.size() + existing_variable->second.size();
+            size_t required_memory = (size_t)match[1].length() + (size_t)match[2].length();
+            if(used_memory - released_memory + required_memory > limits.memory_budget)
+            {
+                if(limits.policy == overflow_policy::error)
+                    throw std::length_error("variables exceed the memory budget");
+                report.skipped_bytes += (size_t)(end_of_line - buffer.begin());
+                report.skipped_lines ++;
+                continue;
+            }
+            used_memory += required_memory - released_memory;
+            variables[name] = match[2].str();
+        }
+    }
+    return variables;
+}
+
+
+int main()
+{
+    reading_limits limits;
+    limits.max_line_length = 256;
+    limits.policy = overflow_policy::truncate;
+
+    reading_report report;
+    auto variables = find_all_variables("C:\\Temp\\variables", limits, report);
+    std::cout << "Number of variables: " << variables.size() << "\n";
+    std::cout << "Skipped lines: " << report.skipped_lines 
+        << ", truncated lines: " << report.truncated_lines
+        << ", skipped bytes: " << report.skipped_bytes << "\n";
+}
@@ -0,0 +1,83 @@
+#include<algorithm>
+#include<fstream>
+#include<iostream>
+#include<iterator>
+#include<map>
+#include<regex>
+
+#include"../part1.3_containeur/buffer.hpp"
+#include"radix_index.hpp"
+#include"../variables_format.hpp"
+#include"../../tracing.hpp"
+
+std::regex match_variables(
+    "^([A-Za-z_][A-Za-z_0-9()]*)\\s*=\\s*(.*)$", 
+    std::regex_constants::ECMAScript);
+
+std::map<std::string, std::string> find_all_variables(std::string filename)
+{
+    using buffer_type = temporary_buffer<char>;
+    using iterator = typename buffer_type::iterator;
+
+    const size_t buffer_size = 80;
+    const size_t increment = 40;
+
+    buffer_type buffer(buffer_size) ;
+    std::map<std::string, std::string> variables;
+    std::ifstream stream(filename);
+
+    while(!stream.eof() && !stream.fail())
+    {
+        // Try to load the full line into the buffer.
+        stream.getline(buffer.data(), buffer.size());
+        size_t number_of_available_chars = (size_t)stream.gcount();
+        while(stream.fail() && !stream.eof() 
+            && number_of_available_chars == buffer.size() - 1)
+        {
+            // Increase the buffer as long as it is required.
+            buffer.increase_by(increment);
+            stream.clear();
+            stream.getline(
+                buffer.data() + number_of_available_chars, 
+                buffer.size() - number_of_available_chars);
+            number_of_available_chars += (size_t)stream.gcount();
+        }
+        TRACE_COUNT(bytes_read, number_of_available_chars);
+        TRACE_COUNT(lines_scanned, 1);
+                        
+        // Test if the line matches the regular expressions and
+        // retrieve the name of the variable and the associated value.
+        iterator end_of_line = std::find(buffer.begin(), buffer.end(), '\0');
+        if((size_t)(end_of_line - buffer.begin()) > max_line_length)
+            continue;
+        std::match_results<iterator> match;
+        bool is_matching;
+        {
+            TRACE_TIME(match_time_ns);
+            is_matching = std::regex_match(buffer.begin(), end_of_line, 
+                match, match_variables);
+        }
+        if(is_matching)
+        {
+            variables[match[1].str()] = match[2].str();
+        }
+    }
+    return variables;
+}
+
+
+int main()
+{
+    auto variables = find_all_variables("C:\\Temp\\variables");
+    radix_index<std::map<std::string, std::string>> index(variables);
+    std::cout << "Number of variables: " << variables.size() << "\n";
+    std::cout << "Index: " << index.number_of_nodes() << " nodes, "
+        << index.memory_usage() << " bytes\n";
+
+    for(auto entry: index.with_prefix("Common"))
+        std::cout << entry->first << "\n";
+
+    auto entry = index.longest_prefix_match("ProgramFiles(x86)\\Common");
+    if(entry != nullptr)
+        std::cout << "Longest prefix: " << entry->first << "\n";
+}
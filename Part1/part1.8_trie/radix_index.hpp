@@ -0,0 +1,185 @@
+#pragma once
+
+#include<algorithm>
+#include<cstdint>
+#include<string>
+#include<string_view>
+#include<vector>
+
+// Radix tree indexing the names of the variables of a map. The index 
+// does not copy the values, each node refers to the entry of the map, 
+// hence the map must outlive the index and must not be modified.
+// All the nodes are stored in a single vector and the children are 
+// referenced by their 32 bits index in this vector.
+template<class Map>
+class radix_index
+{
+public:
+    using map_type = Map;
+    using value_type = typename map_type::value_type;
+    using size_type = size_t;
+
+private:
+    using index_type = std::uint32_t;
+
+    struct node
+    {
+        // Characters on the edge from the parent to this node.
+        std::string m_label;
+        // Sorted by the first character of their labels.
+        std::vector<index_type> m_children;
+        const value_type* m_entry;
+
+        explicit node(std::string_view theLabel, const value_type* theEntry = nullptr):
+            m_label(theLabel), m_children(), m_entry(theEntry)
+            {}
+    };
+
+    std::vector<node> m_nodes;
+
+    // Position in the children of the node where a child starting with
+    // first_character is or should be inserted.
+    typename std::vector<index_type>::const_iterator find_child(
+        const node& parent, char first_character) const
+    {
+        return std::lower_bound(
+            parent.m_children.begin(), parent.m_children.end(), first_character,
+            [this](index_type child, char character) 
+            { 
+                return (unsigned char)m_nodes[child].m_label.front() 
+                    < (unsigned char)character; 
+            });
+    }
+
+    index_type add_node(std::string_view label, const value_type* entry = nullptr)
+    {
+        m_nodes.emplace_back(label, entry);
+        return (index_type)(m_nodes.size() - 1);
+    }
+
+    void insert(const value_type& entry)
+    {
+        std::string_view key = entry.first;
+        index_type current = 0;
+        while(!key.empty())
+        {
+            auto position = find_child(m_nodes[current], key.front());
+            auto offset = position - m_nodes[current].m_children.begin();
+            if(position == m_nodes[current].m_children.end() 
+                || m_nodes[*position].m_label.front() != key.front())
+            {
+                index_type child = add_node(key, &entry);
+                m_nodes[current].m_children.insert(
+                    m_nodes[current].m_children.begin() + offset, child);
+                return;
+            }
+
+            index_type child = *position;
+            const std::string& label = m_nodes[child].m_label;
+            size_type common_length = (size_type)(std::mismatch(
+                label.begin(), label.end(), key.begin(), key.end()).first 
+                - label.begin());
+            if(common_length < label.size())
+            {
+                // Split the edge: the new node holds the common part of
+                // the label and becomes the parent of the former child.
+                std::string common_label = label.substr(0, common_length);
+                index_type middle = add_node(common_label);
+                m_nodes[child].m_label.erase(0, common_length);
+                m_nodes[middle].m_children.push_back(child);
+                m_nodes[current].m_children[offset] = middle;
+                child = middle;
+            }
+            key.remove_prefix(common_length);
+            current = child;
+        }
+        m_nodes[current].m_entry = &entry;
+    }
+
+    template<class Function>
+    void for_each_in_subtree(index_type current, Function& function) const
+    {
+        const node& current_node = m_nodes[current];
+        if(current_node.m_entry != nullptr)
+            function(*current_node.m_entry);
+        for(index_type child: current_node.m_children)
+            for_each_in_subtree(child, function);
+    }
+
+public:
+    explicit radix_index(const map_type& variables)
+    {
+        m_nodes.emplace_back(std::string_view());
+        for(const auto& entry: variables)
+            insert(entry);
+        m_nodes.shrink_to_fit();
+    }
+
+    // Calls function on all the entries whose names start with prefix, 
+    // in the order of their names.
+    template<class Function>
+    void for_each_with_prefix(std::string_view prefix, Function function) const
+    {
+        index_type current = 0;
+        while(!prefix.empty())
+        {
+            auto position = find_child(m_nodes[current], prefix.front());
+            if(position == m_nodes[current].m_children.end())
+                return;
+            const std::string& label = m_nodes[*position].m_label;
+            size_type length = std::min(label.size(), prefix.size());
+            if(label.compare(0, length, prefix.substr(0, length)) != 0)
+                return;
+            prefix.remove_prefix(length);
+            current = *position;
+        }
+        for_each_in_subtree(current, function);
+    }
+
+    std::vector<const value_type*> with_prefix(std::string_view prefix) const
+    {
+        std::vector<const value_type*> entries;
+        for_each_with_prefix(prefix, 
+            [&entries](const value_type& entry) { entries.push_back(&entry); });
+        return entries;
+    }
+
+    // Returns the entry with the longest name that is a prefix of key, 
+    // or nullptr if there is no such entry.
+    const value_type* longest_prefix_match(std::string_view key) const
+    {
+        index_type current = 0;
+        const value_type* longest_match = m_nodes[current].m_entry;
+        while(!key.empty())
+        {
+            auto position = find_child(m_nodes[current], key.front());
+            if(position == m_nodes[current].m_children.end())
+                break;
+            const std::string& label = m_nodes[*position].m_label;
+            if(key.substr(0, label.size()) != label)
+                break;
+            key.remove_prefix(label.size());
+            current = *position;
+            if(m_nodes[current].m_entry != nullptr)
+                longest_match = m_nodes[current].m_entry;
+        }
+        return longest_match;
+    }
+
+    size_type number_of_nodes() const noexcept { return m_nodes.size(); }
+
+    // Number of bytes allocated by the index, the entries of the map are
+    // not taken into account.
+    size_type memory_usage() const noexcept
+    {
+        size_type memory = sizeof(*this) + m_nodes.capacity() * sizeof(node);
+        for(const node& current_node: m_nodes)
+        {
+            // Short labels are stored inside the string object itself.
+            if(current_node.m_label.capacity() > std::string().capacity())
+                memory += current_node.m_label.capacity() + 1;
+            memory += current_node.m_children.capacity() * sizeof(index_type);
+        }
+        return memory;
+    }
+};
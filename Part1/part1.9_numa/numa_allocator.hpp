@@ -0,0 +1,206 @@
+#pragma once
+
+#include<cstddef>
+#include<cstdint>
+#include<filesystem>
+#include<fstream>
+#include<new>
+#include<stdexcept>
+#include<string>
+
+#if defined(__linux__)
+#include<sched.h>
+#include<sys/mman.h>
+#include<sys/syscall.h>
+#include<unistd.h>
+#endif
+
+// Opt-in allocation backend for the large buffers of the readers. On 
+// Linux, the large blocks are mapped with mmap, transparent huge pages 
+// are requested with madvise and the memory is preferably placed on the
+// NUMA node of the calling thread. Each of these steps is a hint: if the
+// kernel does not support huge pages or if the machine has a single node,
+// the memory is used as is. On the other systems, and for the small 
+// blocks, the memory comes from operator new.
+
+namespace numa
+{
+
+constexpr size_t huge_page_size = 2 * 1024 * 1024;
+// Blocks smaller than this threshold are not worth a mapping of their own.
+constexpr size_t mapping_threshold = huge_page_size / 2;
+
+// Returns the NUMA node on which the calling thread runs, -1 if unknown.
+inline int current_node() noexcept
+{
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if(syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+        return (int)node;
+#endif
+    return -1;
+}
+
+// Returns the number of NUMA nodes of the machine, 1 if unknown.
+inline int number_of_nodes() noexcept
+{
+    int count = 0;
+#if defined(__linux__)
+    std::error_code error;
+    for(std::filesystem::directory_iterator entry("/sys/devices/system/node", error), end; 
+        !error && entry != end; entry.increment(error))
+    {
+        std::string name = entry->path().filename().string();
+        if(name.size() > 4 && name.compare(0, 4, "node") == 0 
+            && name.find_first_not_of("0123456789", 4) == std::string::npos)
+            count ++;
+    }
+#endif
+    return count == 0 ? 1 : count;
+}
+
+// Restricts the calling thread to the processors of the node. Returns 
+// false if the processors of the node are unknown or if the thread 
+// cannot be pinned.
+inline bool pin_current_thread(int node)
+{
+#if defined(__linux__)
+    if(node < 0)
+        return false;
+    std::ifstream stream(
+        "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string cpu_list;
+    if(!std::getline(stream, cpu_list))
+        return false;
+
+    // The list is written as ranges, e.g. "0-3,8-11".
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    size_t position = 0;
+    while(position < cpu_list.size())
+    {
+        size_t end_of_range = cpu_list.find(',', position);
+        if(end_of_range == std::string::npos)
+            end_of_range = cpu_list.size();
+        std::string range = cpu_list.substr(position, end_of_range - position);
+        size_t dash = range.find('-');
+        try
+        {
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for(int cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu ++)
+                CPU_SET(cpu, &cpus);
+        }
+        catch(const std::exception&)
+        {
+            return false;
+        }
+        position = end_of_range + 1;
+    }
+    return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+// Same as pin_current_thread(current_node()).
+inline bool pin_current_thread()
+{
+    return pin_current_thread(current_node());
+}
+
+// Length of the mapping of a large block, a multiple of huge_page_size.
+constexpr size_t mapping_length(size_t number_of_bytes) noexcept
+{
+    return (number_of_bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+}
+
+// The large blocks are aligned on huge_page_size, the small blocks on
+// alignment.
+inline void* allocate(size_t number_of_bytes, 
+    size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+{
+#if defined(__linux__)
+    if(number_of_bytes >= mapping_threshold)
+    {
+        // mmap only aligns the mapping on the size of a small page: a 
+        // larger region is mapped and trimmed so that the block starts on
+        // a huge page boundary.
+        size_t length = mapping_length(number_of_bytes);
+        void* region = mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE, 
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(region == MAP_FAILED)
+            throw std::bad_alloc();
+        auto start_of_region = reinterpret_cast<std::uintptr_t>(region);
+        auto start_of_block = (start_of_region + huge_page_size - 1) 
+            / huge_page_size * huge_page_size;
+        size_t head = start_of_block - start_of_region;
+        if(head != 0)
+            munmap(region, head);
+        munmap(reinterpret_cast<void*>(start_of_block + length), huge_page_size - head);
+        void* memory = reinterpret_cast<void*>(start_of_block);
+#if defined(MADV_HUGEPAGE)
+        madvise(memory, length, MADV_HUGEPAGE);
+#endif
+#if defined(SYS_mbind)
+        // MPOL_PREFERRED: the pages are allocated on the node if it has
+        // free memory and elsewhere otherwise.
+        const int preferred_policy = 1;
+        int node = current_node();
+        if(node >= 0 && node < (int)(8 * sizeof(unsigned long)))
+        {
+            unsigned long node_mask = 1UL << node;
+            syscall(SYS_mbind, memory, length, preferred_policy, 
+                &node_mask, 8 * sizeof(node_mask), 0);
+        }
+#endif
+        return memory;
+    }
+#endif
+    return ::operator new(number_of_bytes, std::align_val_t(alignment));
+}
+
+// number_of_bytes and alignment must be the values that were passed to
+// allocate.
+inline void deallocate(void* memory, size_t number_of_bytes, 
+    size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__) noexcept
+{
+#if defined(__linux__)
+    if(number_of_bytes >= mapping_threshold)
+    {
+        munmap(memory, mapping_length(number_of_bytes));
+        return;
+    }
+#endif
+    ::operator delete(memory, std::align_val_t(alignment));
+}
+
+}
+
+// Allocator for the standard containers, e.g. 
+// std::vector<char, huge_page_allocator<char>>.
+template<class T>
+class huge_page_allocator
+{
+public:
+    using value_type = T;
+    using size_type = size_t;
+
+    huge_page_allocator() noexcept = default;
+    template<class U>
+    huge_page_allocator(const huge_page_allocator<U>&) noexcept {}
+
+    T* allocate(size_type number_of_elements)
+    {
+        return static_cast<T*>(numa::allocate(number_of_elements * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* memory, size_type number_of_elements) noexcept
+    {
+        numa::deallocate(memory, number_of_elements * sizeof(T), alignof(T));
+    }
+
+    template<class U>
+    bool operator == (const huge_page_allocator<U>&) const noexcept { return true; }
+};
@@ -0,0 +1,85 @@
+#include<algorithm>
+#include<fstream>
+#include<iostream>
+#include<iterator>
+#include<map>
+#include<regex>
+#include<string>
+
+#include"numa_allocator.hpp"
+#include"../part1.3_containeur/buffer.hpp"
+#include"../variables_format.hpp"
+#include"../../tracing.hpp"
+
+std::regex match_variables(
+    "^([A-Za-z_][A-Za-z_0-9()]*)\\s*=\\s*(.*)$", 
+    std::regex_constants::ECMAScript);
+
+// Reads the file by blocks of 4MB allocated in huge pages on the NUMA 
+// node of the calling thread.
+std::map<std::string, std::string> find_all_variables(std::string filename)
+{
+    using buffer_type = temporary_buffer<char, huge_page_allocator<char>>;
+    using iterator = typename buffer_type::const_iterator;
+
+    const size_t block_size = 2 * numa::huge_page_size;
+
+    buffer_type buffer(block_size);
+    std::map<std::string, std::string> variables;
+    std::ifstream stream(filename, std::ios::binary);
+
+    // Part of a line that spans over two blocks.
+    std::string pending_line;
+    auto match_line = [&variables](auto start_of_line, auto end_of_line)
+    {
+        TRACE_COUNT(lines_scanned, 1);
+        if((size_t)(end_of_line - start_of_line) > max_line_length)
+            return;
+        std::match_results<decltype(start_of_line)> match;
+        bool is_matching;
+        {
+            TRACE_TIME(match_time_ns);
+            is_matching = std::regex_match(start_of_line, end_of_line, match, match_variables);
+        }
+        if(is_matching)
+            variables[match[1].str()] = match[2].str();
+    };
+
+    while(!stream.eof() && !stream.fail())
+    {
+        stream.read(buffer.data(), (std::streamsize)buffer.size());
+        iterator start_of_line = buffer.cbegin();
+        iterator end_of_block = start_of_line + stream.gcount();
+        TRACE_COUNT(bytes_read, stream.gcount());
+        for(iterator end_of_line = std::find(start_of_line, end_of_block, '\n');
+            end_of_line != end_of_block;
+            end_of_line = std::find(start_of_line, end_of_block, '\n'))
+        {
+            if(!pending_line.empty())
+            {
+                pending_line.append(start_of_line, end_of_line);
+                match_line(pending_line.cbegin(), pending_line.cend());
+                pending_line.clear();
+            }
+            else
+                match_line(start_of_line, end_of_line);
+            start_of_line = end_of_line + 1;
+        }
+        pending_line.append(start_of_line, end_of_block);
+    }
+    match_line(pending_line.cbegin(), pending_line.cend());
+    return variables;
+}
+
+
+int main()
+{
+    // The parser stays on the node where its buffers are allocated.
+    int node = numa::current_node();
+    bool is_pinned = numa::pin_current_thread(node);
+    std::cout << "NUMA node: " << node 
+        << (is_pinned ? " (pinned)" : " (not pinned)") << "\n";
+
+    auto variables = find_all_variables("C:\\Temp\\variables");
+    std::cout << "Number of variables: " << variables.size() << "\n";
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include<cstddef>
+
+// Format of the variables files read by the parsers of Part1: each line
+// "NAME = VALUE" that matches ^([A-Za-z_][A-Za-z_0-9()]*)\s*=\s*(.*)$ 
+// defines a variable, the last definition of a variable wins.
+//
+// A line longer than max_line_length is not a definition. The parsers 
+// skip such a line before the match: std::regex recurses once per 
+// character and a line of a few tens of thousands of characters would 
+// overflow the stack.
+constexpr size_t max_line_length = 4096;
@@ -2,12 +2,17 @@
 #include<iostream>
 #include<memory>
 
+#include"../tracing.hpp"
+
 class invalid_iterator: std::exception
 {
+private:
+    const char* m_message;
 public:
-    invalid_iterator() {}
+    invalid_iterator(): m_message("invalid iterator") {}
     invalid_iterator(const char* const &aMessage):
-        exception(aMessage) {}
+        m_message(aMessage) {}
+    const char* what() const noexcept override { return m_message; }
 };
 
 template<typename T>
@@ -57,7 +62,10 @@ public:
         void check_if_is_valid()
         {
             if(m_version != m_list.m_version)
+            {
+                TRACE_COUNT(invalid_iterators, 1);
                 throw invalid_iterator();
+            }
         }
 
     public:        
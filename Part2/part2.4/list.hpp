@@ -0,0 +1,399 @@
+#pragma once
+
+#include<algorithm>
+#include<cstdint>
+#include<deque>
+#include<exception>
+#include<istream>
+#include<iterator>
+#include<limits>
+#include<memory>
+#include<ostream>
+#include<stdexcept>
+#include<type_traits>
+#include<utility>
+#include<vector>
+
+#include"../../tracing.hpp"
+
+class invalid_iterator: std::exception
+{
+private:
+    const char* m_message;
+public:
+    invalid_iterator(): m_message("invalid iterator") {}
+    invalid_iterator(const char* const &aMessage):
+        m_message(aMessage) {}
+    const char* what() const noexcept override { return m_message; }
+};
+
+// Singly linked list whose nodes are stored in arrays instead of being
+// allocated one by one in the heap. The values and the links are kept in
+// separate arrays (structure of arrays) and a link is the 32 bits index 
+// of the next node in these arrays.
+//
+// When a node is removed, its slot is recycled and the generation of the
+// slot is incremented. An iterator or a handle records the generation of
+// the slot it refers to and throws invalid_iterator if the slot has been
+// recycled since. Adding elements never invalidates them, even when the
+// arrays are reallocated.
+//
+// Every checkpoint_interval insertions at the front or at the back, the
+// inserted node is recorded as a checkpoint. The checkpoints are kept in
+// the order of the list and split it into segments of similar lengths
+// that may be traversed in parallel.
+//
+// The arrays are allocated with Allocator, e.g. huge_page_allocator from
+// Part1/part1.9_numa to place them in huge pages.
+template<typename T, class Allocator = std::allocator<T>>
+class List
+{
+private:
+    using index_type = std::uint32_t;
+    using generation_type = std::uint32_t;
+
+    static constexpr index_type null_index = std::numeric_limits<index_type>::max();
+
+    template<class U>
+    using array_type = std::vector<U, 
+        typename std::allocator_traits<Allocator>::template rebind_alloc<U>>;
+
+    array_type<T> m_values;
+    array_type<index_type> m_next;
+    array_type<generation_type> m_generations;
+    index_type m_front;
+    index_type m_back;
+    // Slots of the removed nodes, chained through m_next.
+    index_type m_free;
+    size_t m_size;
+
+    static constexpr size_t checkpoint_interval = 4096;
+    std::deque<index_type> m_checkpoints;
+    size_t m_front_insertions;
+    size_t m_back_insertions;
+
+    void rebuild_checkpoints()
+    {
+        m_checkpoints.clear();
+        m_front_insertions = m_back_insertions = 0;
+        size_t position = 0;
+        for(index_type index = m_front; index != null_index; index = m_next[index])
+        {
+            if(position != 0 && position % checkpoint_interval == 0)
+                m_checkpoints.push_back(index);
+            position ++;
+        }
+    }
+
+    void check_if_is_valid(index_type index, generation_type generation) const
+    {
+        if(index >= m_generations.size() || m_generations[index] != generation)
+        {
+            TRACE_COUNT(invalid_iterators, 1);
+            throw invalid_iterator();
+        }
+    }
+
+    index_type allocate(T value, index_type next)
+    {
+        TRACE_COUNT(node_allocations, 1);
+        index_type index = m_free;
+        if(index != null_index)
+        {
+            m_free = m_next[index];
+            m_values[index] = std::move(value);
+            m_next[index] = next;
+        }
+        else
+        {
+            if(m_values.size() >= null_index)
+                throw std::length_error("List: too many elements");
+            index = (index_type)m_values.size();
+            m_values.push_back(std::move(value));
+            m_next.push_back(next);
+            m_generations.push_back(0);
+        }
+        m_size ++;
+        return index;
+    }
+
+public:
+    using value_type = T;
+    using pointer = value_type*;
+    using reference = T&;
+    using size_type = size_t;
+
+    // Reference to an element that remains valid as long as the element 
+    // is not removed from the list.
+    class handle
+    {
+    private:
+        friend class List<T, Allocator>;
+        index_type m_index;
+        generation_type m_generation;
+
+        handle(index_type theIndex, generation_type theGeneration):
+            m_index(theIndex), m_generation(theGeneration) {}
+    public:
+        handle(): m_index(null_index), m_generation(0) {}
+        bool operator == (const handle&) const = default;
+    };
+
+    class iterator
+    {
+    private:
+        friend class List<T, Allocator>;
+        List<T, Allocator>* m_list;
+        index_type m_current;
+        generation_type m_generation;
+
+        void check_if_is_valid() const
+        {
+            if(m_current != null_index)
+                m_list->check_if_is_valid(m_current, m_generation);
+        }
+
+    public:        
+        using difference_type = typename std::iterator_traits<T*>::difference_type;
+        using value_type = typename std::iterator_traits<T*>::value_type;
+        using pointer = typename std::iterator_traits<T*>::pointer;
+        using reference = typename std::iterator_traits<T*>::reference;
+        using iterator_category = typename std::forward_iterator_tag;
+        using iterator_concept = typename std::forward_iterator_tag;
+
+        iterator(): m_list(nullptr), m_current(null_index), m_generation(0) {}
+        iterator(List<T, Allocator>& theList, index_type theIndex):
+            m_list(&theList), m_current(theIndex), 
+            m_generation(theIndex == null_index ? 0 : theList.m_generations[theIndex])
+            {}
+        iterator& operator++()
+        {
+            check_if_is_valid();
+            if(m_current != null_index)
+            {
+                m_current = m_list->m_next[m_current];
+                m_generation = m_current == null_index ? 0 
+                    : m_list->m_generations[m_current];
+            }
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            auto result = iterator(*this);
+            ++*this;
+            return result;
+        }
+        reference operator *() const
+        {
+            check_if_is_valid();
+            return m_list->m_values[m_current];
+        }
+        pointer operator ->() const
+        {
+            check_if_is_valid();
+            return &m_list->m_values[m_current];
+        }
+        handle get_handle() const
+        {
+            check_if_is_valid();
+            return handle(m_current, m_generation);
+        }
+        bool operator == (const iterator& another) const 
+        { 
+            return m_current == another.m_current; 
+        }
+        bool operator != (const iterator& another) const 
+        { 
+            return m_current != another.m_current; 
+        }
+    };
+
+    List(): 
+        m_front(null_index), m_back(null_index), m_free(null_index), m_size(0),
+        m_checkpoints(), m_front_insertions(0), m_back_insertions(0)
+        {}
+
+    iterator begin() { return iterator(*this, m_front); }
+    iterator end() { return iterator(*this, null_index); }
+
+    size_type size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    // Reserves the memory for number_of_elements nodes.
+    void reserve(size_type number_of_elements)
+    {
+        m_values.reserve(number_of_elements);
+        m_next.reserve(number_of_elements);
+        m_generations.reserve(number_of_elements);
+    }
+
+    handle push_front(T value)
+    {
+        m_front = allocate(std::move(value), m_front);
+        if(m_back == null_index)
+            m_back = m_front;
+        if(++ m_front_insertions == checkpoint_interval)
+        {
+            m_checkpoints.push_front(m_front);
+            m_front_insertions = 0;
+        }
+        return handle(m_front, m_generations[m_front]);
+    }
+    handle push_back(T value)
+    {
+        index_type index = allocate(std::move(value), null_index);
+        if(m_back == null_index)
+            m_front = index;
+        else
+            m_next[m_back] = index;
+        m_back = index;
+        if(++ m_back_insertions == checkpoint_interval)
+        {
+            m_checkpoints.push_back(index);
+            m_back_insertions = 0;
+        }
+        return handle(index, m_generations[index]);
+    }
+
+    // Removes the first element, the handles and the iterators referring
+    // to it become invalid. The slot is reused by the next insertion.
+    void pop_front()
+    {
+        if(m_front == null_index)
+            return;
+        index_type index = m_front;
+        m_front = m_next[index];
+        if(m_front == null_index)
+            m_back = null_index;
+        // Only the first checkpoint may be the first node of the list.
+        if(!m_checkpoints.empty() && m_checkpoints.front() == index)
+            m_checkpoints.pop_front();
+        m_generations[index] ++;
+        m_next[index] = m_free;
+        m_free = index;
+        m_size --;
+    }
+
+    // Splits the list into segments delimited by the checkpoints. The 
+    // segment i is [boundaries[i], boundaries[i + 1]), the last boundary
+    // is end().
+    std::vector<iterator> segments()
+    {
+        std::vector<iterator> boundaries;
+        boundaries.reserve(m_checkpoints.size() + 2);
+        boundaries.push_back(begin());
+        for(index_type checkpoint: m_checkpoints)
+        {
+            if(checkpoint != m_front)
+                boundaries.push_back(iterator(*this, checkpoint));
+        }
+        boundaries.push_back(end());
+        return boundaries;
+    }
+
+    reference operator[](handle theHandle)
+    {
+        check_if_is_valid(theHandle.m_index, theHandle.m_generation);
+        return m_values[theHandle.m_index];
+    }
+    bool is_valid(handle theHandle) const noexcept
+    {
+        return theHandle.m_index < m_generations.size() 
+            && m_generations[theHandle.m_index] == theHandle.m_generation;
+    }
+
+    // The arrays are written and read as raw bytes, one block per array.
+    void save(std::ostream& stream) const requires std::is_trivially_copyable_v<T>
+    {
+        index_type header[4] = { (index_type)m_values.size(), m_front, m_back, m_free };
+        stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(m_values.data()), 
+            (std::streamsize)(m_values.size() * sizeof(T)));
+        stream.write(reinterpret_cast<const char*>(m_next.data()), 
+            (std::streamsize)(m_next.size() * sizeof(index_type)));
+        stream.write(reinterpret_cast<const char*>(m_generations.data()), 
+            (std::streamsize)(m_generations.size() * sizeof(generation_type)));
+        stream.write(reinterpret_cast<const char*>(&m_size), sizeof(m_size));
+    }
+    // The saved list is read and checked before it replaces the content
+    // of the list: on failure std::runtime_error is thrown and the list
+    // is left unchanged.
+    void load(std::istream& stream) requires std::is_trivially_copyable_v<T>
+    {
+        auto read = [&stream](void* data, size_t number_of_bytes)
+        {
+            if(!stream.read(static_cast<char*>(data), (std::streamsize)number_of_bytes))
+                throw std::runtime_error("List: cannot read the saved list");
+        };
+        auto is_valid_index = [](index_type index, index_type number_of_slots)
+        {
+            return index < number_of_slots || index == null_index;
+        };
+
+        index_type header[4] = {};
+        read(header, sizeof(header));
+        index_type number_of_slots = header[0];
+        if(number_of_slots == null_index || !is_valid_index(header[1], number_of_slots)
+            || !is_valid_index(header[2], number_of_slots) 
+            || !is_valid_index(header[3], number_of_slots))
+            throw std::runtime_error("List: invalid saved list");
+
+        // The arrays grow by bounded chunks as the data is read: a corrupted
+        // number of slots ends at the end of the stream instead of 
+        // allocating its whole size first.
+        auto read_array = [&read, number_of_slots](auto& array)
+        {
+            const size_t elements_per_chunk = 64 * 1024;
+            while(array.size() < number_of_slots)
+            {
+                size_t offset = array.size();
+                size_t number_of_elements = std::min<size_t>(elements_per_chunk, 
+                    number_of_slots - offset);
+                array.resize(offset + number_of_elements);
+                read(array.data() + offset, 
+                    number_of_elements * sizeof(typename std::decay_t<decltype(array)>::value_type));
+            }
+        };
+        array_type<T> values(m_values.get_allocator());
+        array_type<index_type> next(m_next.get_allocator());
+        array_type<generation_type> generations(m_generations.get_allocator());
+        size_t size = 0;
+        read_array(values);
+        read_array(next);
+        read_array(generations);
+        read(&size, sizeof(size));
+
+        // The nodes and the free slots must form two disjoint chains ending
+        // with null_index that cover all the slots, so that the traversals
+        // of the list always terminate.
+        std::vector<bool> is_used(number_of_slots, false);
+        auto length_of_chain = [&](index_type index)
+        {
+            size_t length = 0;
+            index_type last = null_index;
+            for(; index != null_index; index = next[index])
+            {
+                if(index >= number_of_slots || is_used[index])
+                    throw std::runtime_error("List: invalid saved list");
+                is_used[index] = true;
+                last = index;
+                length ++;
+            }
+            return std::make_pair(length, last);
+        };
+        auto [number_of_nodes, last_node] = length_of_chain(header[1]);
+        auto [number_of_free_slots, last_free_slot] = length_of_chain(header[3]);
+        if(number_of_nodes != size || last_node != header[2]
+            || number_of_nodes + number_of_free_slots != number_of_slots)
+            throw std::runtime_error("List: invalid saved list");
+
+        m_values.swap(values);
+        m_next.swap(next);
+        m_generations.swap(generations);
+        m_front = header[1];
+        m_back = header[2];
+        m_free = header[3];
+        m_size = size;
+        rebuild_checkpoints();
+    }
+};
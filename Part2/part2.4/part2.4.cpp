@@ -0,0 +1,57 @@
+#include<cstdint>
+#include<iostream>
+#include<sstream>
+#include<stdexcept>
+#include<string>
+
+#include"list.hpp"
+
+int main()
+{
+    List<int> list;
+    list.push_back(0);
+    for(int i = 1; i<5; i++)
+    {
+        list.push_back(i);
+        list.push_front(i);
+    }
+    for(auto it = list.begin(); it != list.end(); it++)
+        std::cout << *it << "\n";
+
+    // The list is copied by writing its arrays as blocks of bytes.
+    std::stringstream stream;
+    list.save(stream);
+    List<int> copy;
+    copy.load(stream);
+    std::cout << "Copy: " << copy.size() << " elements\n";
+
+    // A corrupted number of slots fails at the end of the stream, without
+    // allocating the arrays of that size.
+    std::string saved = stream.str();
+    std::uint32_t number_of_slots = 0xFFFFFFFE;
+    saved.replace(0, sizeof(number_of_slots), 
+        reinterpret_cast<const char*>(&number_of_slots), sizeof(number_of_slots));
+    std::istringstream corrupted(saved);
+    try
+    {
+        copy.load(corrupted);
+    }
+    catch(const std::runtime_error& error)
+    {
+        std::cout << error.what() << ", copy: " << copy.size() << " elements\n";
+    }
+
+    // The iterator refers to the first element, the slot of the element
+    // is recycled by the push_back.
+    auto first = list.begin();
+    list.pop_front();
+    list.push_back(5);
+    try
+    {
+        std::cout << *first << "\n";
+    }
+    catch(const invalid_iterator&)
+    {
+        std::cout << "Invalid iterator\n";
+    }
+}
@@ -0,0 +1,201 @@
+#pragma once
+
+#include<iterator>
+
+#include"../../tracing.hpp"
+
+// Doubly linked list: each node knows the previous and the next node, 
+// hence the elements can be inserted or removed anywhere in the list in
+// constant time given an iterator. As in part2.0, the nodes are allocated
+// one by one with new and deleted by the list.
+template<typename T>
+class List
+{
+private:
+    struct Node
+    {
+    private:
+        T m_value;
+        Node* m_previous_node;
+        Node* m_next_node;
+
+    public:
+        Node(T aValue, Node* thePreviousNode, Node* theNextNode):
+            m_value(aValue), 
+            m_previous_node(thePreviousNode), m_next_node(theNextNode)
+            {}
+        
+        Node*& previous() { return m_previous_node; }
+        Node*& next() { return m_next_node; }
+        T& value() { return m_value; }
+        T value() const { return m_value; }
+    };
+
+    Node* m_front;
+    Node* m_back;
+    size_t m_size;
+
+    // Inserts a new node before the node next_node, at the end of the list
+    // if next_node is NULL.
+    Node* insert_before(Node* next_node, T value)
+    {
+        Node* previous_node = next_node == NULL ? m_back : next_node->previous();
+        Node* node = new Node(value, previous_node, next_node);
+        TRACE_COUNT(node_allocations, 1);
+        link(node);
+        return node;
+    }
+    // Makes the neighbours of the node point to it.
+    void link(Node* node)
+    {
+        if(node->previous() == NULL)
+            m_front = node;
+        else
+            node->previous()->next() = node;
+        if(node->next() == NULL)
+            m_back = node;
+        else
+            node->next()->previous() = node;
+        m_size ++;
+    }
+    // Removes the node from the list without deleting it.
+    void unlink(Node* node)
+    {
+        if(node->previous() == NULL)
+            m_front = node->next();
+        else
+            node->previous()->next() = node->next();
+        if(node->next() == NULL)
+            m_back = node->previous();
+        else
+            node->next()->previous() = node->previous();
+        m_size --;
+    }
+
+public:
+    using value_type = T;
+    using pointer = value_type*;
+    using reference = T&;
+    using size_type = size_t;
+
+    class iterator
+    {
+    private:
+        friend class List<T>;
+        Node* m_current;
+        const List<T>* m_list;
+
+    public:        
+        using difference_type = typename std::iterator_traits<T*>::difference_type;
+        using value_type = typename std::iterator_traits<T*>::value_type;
+        using pointer = typename std::iterator_traits<T*>::pointer;
+        using reference = typename std::iterator_traits<T*>::reference;
+        using iterator_category = typename std::bidirectional_iterator_tag;
+        using iterator_concept = typename std::bidirectional_iterator_tag;
+
+        iterator(): m_current(NULL), m_list(NULL) {}
+        iterator(const List<T>& theList, Node* node): 
+            m_current(node), m_list(&theList)
+            {}
+        iterator& operator++()
+        {
+            if(m_current != NULL)
+                m_current = m_current->next();
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            auto result = iterator(*this);
+            ++*this;
+            return result;
+        }
+        // Decrementing end() moves to the last element of the list.
+        iterator& operator--()
+        {
+            m_current = m_current == NULL ? m_list->m_back : m_current->previous();
+            return *this;
+        }
+        iterator operator--(int)
+        {
+            auto result = iterator(*this);
+            --*this;
+            return result;
+        }
+        reference operator *() const
+        {
+            return m_current->value();
+        }
+        pointer operator ->() const
+        {
+            return &(m_current->value());
+        }
+        bool operator == (const iterator& another) const { return m_current == another.m_current; }
+        bool operator != (const iterator& another) const { return m_current != another.m_current; }
+    };
+
+    List(): m_front(NULL), m_back(NULL), m_size(0) {}
+    List(const List<T>&) = delete;
+    ~List()
+    {
+        clear();
+    }
+    List<T>& operator = (const List<T>&) = delete;
+
+    iterator begin() { return iterator(*this, m_front); }
+    iterator end() { return iterator(*this, NULL); }
+
+    size_type size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    reference front() { return m_front->value(); }
+    reference back() { return m_back->value(); }
+
+    void push_front(T value) { insert_before(m_front, value); }
+    void push_back(T value) { insert_before(NULL, value); }
+
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(iterator(*this, m_back)); }
+
+    // Inserts the value before position and returns an iterator on the 
+    // new element.
+    iterator insert(iterator position, T value)
+    {
+        return iterator(*this, insert_before(position.m_current, value));
+    }
+    // Removes the element at position and returns an iterator on the 
+    // next element. Only the iterators on the removed element become
+    // invalid.
+    iterator erase(iterator position)
+    {
+        Node* node = position.m_current;
+        if(node == NULL)
+            return end();
+        Node* next_node = node->next();
+        unlink(node);
+        delete node;
+        return iterator(*this, next_node);
+    }
+    // Moves the element at position to the front of the list without 
+    // allocating a new node, the iterator remains valid.
+    void move_to_front(iterator position)
+    {
+        Node* node = position.m_current;
+        if(node == NULL || node == m_front)
+            return;
+        unlink(node);
+        node->previous() = NULL;
+        node->next() = m_front;
+        link(node);
+    }
+    void clear()
+    {
+        for(auto m_current = m_front; m_current != NULL; )
+        {
+            auto m_next = m_current->next();
+            delete m_current;
+            m_current = m_next;
+        }
+        m_front = m_back = NULL;
+        m_size = 0;
+    }
+};
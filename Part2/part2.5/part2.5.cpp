@@ -0,0 +1,29 @@
+#include<iostream>
+
+#include"list.hpp"
+
+int main()
+{
+    List<int> list;
+    list.push_back(0);
+    for(int i = 1; i<5; i++)
+    {
+        list.push_back(i);
+        list.push_front(i);
+    }
+
+    list.pop_front();
+    list.pop_back();
+    auto it = list.begin();
+    ++it;
+    it = list.erase(it);
+    list.insert(it, 10);
+    list.move_to_front(--list.end());
+
+    for(auto it = list.begin(); it != list.end(); it++)
+        std::cout << *it << "\n";
+    std::cout << "Reverse:";
+    for(auto it = list.end(); it != list.begin(); )
+        std::cout << " " << *--it;
+    std::cout << "\n";
+}
@@ -0,0 +1,51 @@
+#include<algorithm>
+#include<fstream>
+#include<iostream>
+#include<iterator>
+#include<map>
+#include<memory>
+#include<regex>
+
+#include"variables_cache.hpp"
+
+std::regex match_variables(
+    "^([A-Za-z_][A-Za-z_0-9()]*)\\s*=\\s*(.*)$", 
+    std::regex_constants::ECMAScript);
+
+std::map<std::string, std::string> find_all_variables(const std::string& filename)
+{
+    std::map<std::string, std::string> variables;
+    std::ifstream stream(filename);
+    std::string line;
+    std::smatch match;
+    while(std::getline(stream, line))
+    {
+        if(std::regex_match(line, match, match_variables))
+            variables[match[1].str()] = match[2].str();
+    }
+    return variables;
+}
+
+// Cache shared by all the services of the process.
+variables_cache& shared_variables_cache()
+{
+    static variables_cache cache(find_all_variables, 16 * 1024 * 1024, 
+        std::chrono::minutes(5));
+    return cache;
+}
+
+int main()
+{
+    auto& cache = shared_variables_cache();
+    auto variables = cache.get("C:\\Temp\\variables");
+    std::cout << "Number of variables: " << variables->size() << "\n";
+
+    for(int i = 0; i < 10; i++)
+        variables = cache.get("C:\\Temp\\variables");
+
+    auto statistics = cache.get_statistics();
+    std::cout << "Hits: " << statistics.hits 
+        << ", misses: " << statistics.misses
+        << ", evictions: " << statistics.evictions
+        << ", bytes: " << statistics.used_bytes << "\n";
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include<chrono>
+#include<cstdint>
+#include<filesystem>
+#include<functional>
+#include<map>
+#include<memory>
+#include<mutex>
+#include<string>
+#include<system_error>
+#include<unordered_map>
+
+#if defined(__unix__)
+#include<sys/stat.h>
+#endif
+
+#include"../part2.5/list.hpp"
+
+// Cache of the variables loaded from files, indexed by the path of the 
+// file. The variables are shared with the callers through a 
+// std::shared_ptr on an immutable map: an entry evicted from the cache 
+// stays alive as long as a caller still uses it.
+//
+// An entry is reloaded when the file has been modified (its modification
+// time or its size differs, or on Unix its device or inode number, as
+// when the file is replaced by a rename) or when it is older than the 
+// time to live.
+// When the size of the entries exceeds the budget, the least recently 
+// used entries are evicted.
+class variables_cache
+{
+public:
+    using variables_type = std::map<std::string, std::string>;
+    using pointer = std::shared_ptr<const variables_type>;
+    using loader_type = std::function<variables_type(const std::string&)>;
+    using clock_type = std::chrono::steady_clock;
+    using duration = clock_type::duration;
+    using size_type = size_t;
+
+    struct statistics
+    {
+        size_type hits = 0;
+        size_type misses = 0;
+        size_type evictions = 0;
+        size_type used_bytes = 0;
+    };
+
+private:
+    struct file_stamp
+    {
+        std::filesystem::file_time_type last_write_time;
+        std::uintmax_t file_size = 0;
+#if defined(__unix__)
+        dev_t device = 0;
+        ino_t inode = 0;
+#endif
+
+        bool operator == (const file_stamp&) const = default;
+    };
+
+    struct entry
+    {
+        pointer variables;
+        List<std::string>::iterator position;
+        size_type bytes;
+        clock_type::time_point load_time;
+        file_stamp stamp;
+    };
+
+    loader_type m_loader;
+    size_type m_byte_budget;
+    // A zero duration means that the entries never expire.
+    duration m_time_to_live;
+
+    std::mutex m_mutex;
+    // Paths of the entries, the most recently used first.
+    List<std::string> m_recently_used;
+    std::unordered_map<std::string, entry> m_entries;
+    statistics m_statistics;
+
+    static bool stamp_of(const std::string& path, file_stamp& stamp)
+    {
+        std::error_code error;
+        stamp.last_write_time = std::filesystem::last_write_time(path, error);
+        if(error)
+            return false;
+        stamp.file_size = std::filesystem::file_size(path, error);
+        if(error)
+            return false;
+#if defined(__unix__)
+        struct stat status;
+        if(::stat(path.c_str(), &status) != 0)
+            return false;
+        stamp.device = status.st_dev;
+        stamp.inode = status.st_ino;
+#endif
+        return true;
+    }
+
+    // Approximation of the memory used by the map: the characters of the
+    // strings and one node per variable.
+    static size_type bytes_of(const variables_type& variables)
+    {
+        size_type bytes = sizeof(variables_type);
+        for(const auto& [name, value]: variables)
+            bytes += sizeof(variables_type::value_type) + 4 * sizeof(void*)
+                + name.capacity() + value.capacity();
+        return bytes;
+    }
+
+    // The mutex must be locked by the caller.
+    void remove(std::unordered_map<std::string, entry>::iterator position)
+    {
+        m_statistics.used_bytes -= position->second.bytes;
+        m_recently_used.erase(position->second.position);
+        m_entries.erase(position);
+    }
+
+public:
+    variables_cache(loader_type theLoader, size_type theByteBudget, 
+        duration theTimeToLive = duration::zero()):
+        m_loader(std::move(theLoader)), m_byte_budget(theByteBudget), 
+        m_time_to_live(theTimeToLive)
+        {}
+    variables_cache(const variables_cache&) = delete;
+    variables_cache& operator = (const variables_cache&) = delete;
+
+    // Returns the variables of the file, the file is parsed only if it is
+    // not in the cache or if the cached entry is no longer valid.
+    pointer get(const std::string& path)
+    {
+        file_stamp stamp;
+        bool has_stamp = stamp_of(path, stamp);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto position = m_entries.find(path);
+            if(position != m_entries.end())
+            {
+                entry& cached = position->second;
+                bool is_expired = m_time_to_live != duration::zero()
+                    && clock_type::now() - cached.load_time > m_time_to_live;
+                if(!is_expired && has_stamp && cached.stamp == stamp)
+                {
+                    m_recently_used.move_to_front(cached.position);
+                    m_statistics.hits ++;
+                    return cached.variables;
+                }
+                remove(position);
+            }
+            m_statistics.misses ++;
+        }
+
+        // The file is parsed without holding the lock, two threads asking
+        // for the same file at the same time may both parse it.
+        auto variables = std::make_shared<const variables_type>(m_loader(path));
+        size_type bytes = bytes_of(*variables);
+        if(!has_stamp || bytes > m_byte_budget)
+            return variables;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto position = m_entries.find(path);
+        if(position != m_entries.end())
+            remove(position);
+        while(!m_recently_used.empty() 
+            && m_statistics.used_bytes + bytes > m_byte_budget)
+        {
+            remove(m_entries.find(m_recently_used.back()));
+            m_statistics.evictions ++;
+        }
+        m_recently_used.push_front(path);
+        m_entries.emplace(path, 
+            entry{ variables, m_recently_used.begin(), bytes, clock_type::now(), stamp });
+        m_statistics.used_bytes += bytes;
+        return variables;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+        m_recently_used.clear();
+        m_statistics.used_bytes = 0;
+    }
+
+    statistics get_statistics()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_statistics;
+    }
+};
@@ -0,0 +1,139 @@
+#include<algorithm>
+#include<atomic>
+#include<chrono>
+#include<fstream>
+#include<iostream>
+#include<map>
+#include<regex>
+#include<string>
+#include<thread>
+#include<vector>
+
+#include"snapshot.hpp"
+
+std::regex match_variables(
+    "^([A-Za-z_][A-Za-z_0-9()]*)\\s*=\\s*(.*)$", 
+    std::regex_constants::ECMAScript);
+
+std::map<std::string, std::string> find_all_variables(const std::string& filename)
+{
+    std::map<std::string, std::string> variables;
+    std::ifstream stream(filename);
+    std::string line;
+    std::smatch match;
+    while(std::getline(stream, line))
+    {
+        if(std::regex_match(line, match, match_variables))
+            variables[match[1].str()] = match[2].str();
+    }
+    return variables;
+}
+
+struct measure
+{
+    double lookups_per_second;
+    std::chrono::steady_clock::duration worst_latency;
+    unsigned number_of_reloads;
+};
+
+// The readers look up the variables during the given duration while the
+// writer reloads them every 10ms, or not at all.
+measure measure_lookups(snapshot<std::map<std::string, std::string>>& variables,
+    const std::vector<std::string>& names, unsigned number_of_readers, 
+    std::chrono::steady_clock::duration duration, bool with_reloads, 
+    const std::string& filename)
+{
+    using clock_type = std::chrono::steady_clock;
+
+    std::atomic<bool> is_running(true);
+    std::vector<unsigned long long> lookups(number_of_readers);
+    std::vector<clock_type::duration> worst_latencies(number_of_readers);
+    std::vector<std::thread> readers;
+    auto start_of_measure = clock_type::now();
+    for(unsigned index = 0; index < number_of_readers; index ++)
+    {
+        readers.emplace_back([&, index]()
+        {
+            snapshot<std::map<std::string, std::string>>::reader reader(variables);
+            unsigned long long number_of_lookups = 0;
+            clock_type::duration worst_latency(0);
+            while(is_running.load(std::memory_order_relaxed))
+            {
+                auto start = clock_type::now();
+                auto& current = reader.load();
+                current->find(names[number_of_lookups % names.size()]);
+                auto latency = clock_type::now() - start;
+                number_of_lookups ++;
+                worst_latency = std::max(worst_latency, latency);
+            }
+            lookups[index] = number_of_lookups;
+            worst_latencies[index] = worst_latency;
+        });
+    }
+
+    unsigned number_of_reloads = 0;
+    for(auto end = start_of_measure + duration; clock_type::now() < end; )
+    {
+        if(with_reloads)
+        {
+            variables.publish(find_all_variables(filename));
+            number_of_reloads ++;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    is_running = false;
+    for(auto& reader: readers)
+        reader.join();
+    std::chrono::duration<double> elapsed = clock_type::now() - start_of_measure;
+
+    unsigned long long total_lookups = 0;
+    for(auto number_of_lookups: lookups)
+        total_lookups += number_of_lookups;
+    return { total_lookups / elapsed.count(), 
+        *std::max_element(worst_latencies.begin(), worst_latencies.end()),
+        number_of_reloads };
+}
+
+int main(int argc, char* argv[])
+{
+    // Target: 1M lookups/s across 32 readers with a flat latency while
+    // the variables are reloaded.
+    const unsigned target_number_of_readers = 32;
+    const double target_lookups_per_second = 1e6;
+
+    const unsigned number_of_readers = argc > 1 ? 
+        (unsigned)std::stoul(argv[1]) : target_number_of_readers;
+    const auto duration = std::chrono::seconds(1);
+    const std::string filename = "C:\\Temp\\variables";
+
+    snapshot<std::map<std::string, std::string>> variables(find_all_variables(filename));
+    std::vector<std::string> names;
+    for(auto& [name, value]: *variables.load())
+        names.push_back(name);
+    if(names.empty())
+        names.push_back("PATH");
+
+    bool is_target_met = true;
+    for(bool with_reloads: { false, true })
+    {
+        auto result = measure_lookups(variables, names, number_of_readers, 
+            duration, with_reloads, filename);
+        std::cout << (with_reloads ? "With reloads" : "Without reloads")
+            << ": readers: " << number_of_readers 
+            << ", reloads: " << result.number_of_reloads
+            << ", lookups/s: " << (unsigned long long)result.lookups_per_second
+            << ", worst latency: " 
+            << std::chrono::duration_cast<std::chrono::microseconds>(
+                result.worst_latency).count() 
+            << "us\n";
+        is_target_met = is_target_met 
+            && result.lookups_per_second >= target_lookups_per_second;
+    }
+    std::cout << "Target of " << (unsigned long long)target_lookups_per_second 
+        << " lookups/s with " << number_of_readers << " readers: " 
+        << (is_target_met ? "met" : "missed") << "\n";
+    if(number_of_readers < target_number_of_readers)
+        std::cout << "Warning: the target is defined for " 
+            << target_number_of_readers << " readers\n";
+    return is_target_met ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include<atomic>
+#include<memory>
+#include<utility>
+
+// Holds the current version of an immutable value shared between many 
+// readers and a few writers. A reader gets a snapshot, a std::shared_ptr
+// on the current version, and may use it as long as required. A writer
+// builds the new version aside and publishes it atomically: the readers
+// that already hold the previous version keep it alive, it is destroyed
+// when the last of them releases it.
+//
+// load() is not free: std::atomic<std::shared_ptr> is not lock-free in
+// libstdc++ and each load updates the reference count shared by all the
+// readers. A thread that reads often uses a reader instead, it keeps its
+// own copy of the pointer and only loads it again when the version
+// number, a lock-free integer, changes.
+template<class T>
+class snapshot
+{
+public:
+    using value_type = T;
+    using pointer = std::shared_ptr<const value_type>;
+    using version_type = unsigned long long;
+
+private:
+    std::atomic<pointer> m_current;
+    std::atomic<version_type> m_version;
+
+    static_assert(std::atomic<version_type>::is_always_lock_free);
+
+public:
+    snapshot(): 
+        m_current(std::make_shared<const value_type>()), m_version(0) 
+        {}
+    explicit snapshot(value_type aValue): 
+        m_current(std::make_shared<const value_type>(std::move(aValue))), 
+        m_version(0) 
+        {}
+    snapshot(const snapshot&) = delete;
+    snapshot& operator = (const snapshot&) = delete;
+
+    pointer load() const noexcept 
+    { 
+        return m_current.load(std::memory_order_acquire); 
+    }
+
+    // Cached access to the snapshot owned by a single thread. The cached
+    // version is kept alive until the reader sees a new version number.
+    class reader
+    {
+    private:
+        const snapshot<value_type>* m_snapshot;
+        version_type m_version;
+        pointer m_current;
+
+    public:
+        explicit reader(const snapshot<value_type>& theSnapshot):
+            m_snapshot(&theSnapshot), 
+            m_version(theSnapshot.version()),
+            m_current(theSnapshot.load())
+            {}
+
+        const pointer& load()
+        {
+            // The version is always read before the pointer: if a writer
+            // publishes in between, the pointer is only loaded once more.
+            version_type version = m_snapshot->version();
+            if(version != m_version)
+            {
+                m_current = m_snapshot->load();
+                m_version = version;
+            }
+            return m_current;
+        }
+    };
+
+    // Number of versions that have been published.
+    version_type version() const noexcept 
+    { 
+        return m_version.load(std::memory_order_acquire); 
+    }
+
+    void publish(pointer aValue)
+    {
+        m_current.store(std::move(aValue), std::memory_order_release);
+        m_version.fetch_add(1, std::memory_order_acq_rel);
+    }
+    void publish(value_type aValue)
+    {
+        publish(std::make_shared<const value_type>(std::move(aValue)));
+    }
+
+    // Builds the new version from the current one. If another writer 
+    // published a version meanwhile, the update is computed again from 
+    // this version.
+    template<class Function>
+    void update(Function function)
+    {
+        pointer current = load();
+        pointer next;
+        do
+        {
+            next = std::make_shared<const value_type>(function(*current));
+        }
+        while(!m_current.compare_exchange_weak(current, next, 
+            std::memory_order_acq_rel, std::memory_order_acquire));
+        m_version.fetch_add(1, std::memory_order_acq_rel);
+    }
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include<algorithm>
+#include<exception>
+#include<optional>
+#include<thread>
+#include<vector>
+
+// Parallel algorithms over the lists that can be split into segments 
+// (see List::segments in part2.4). The segments are distributed in 
+// contiguous groups over the threads, each thread traverses its own 
+// group with the forward iterator of the list.
+
+namespace parallel
+{
+
+inline size_t default_number_of_threads()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+namespace detail
+{
+
+// At least one thread and at most one thread per segment.
+inline size_t clamp_number_of_threads(size_t number_of_threads, size_t number_of_segments)
+{
+    return std::max<size_t>(1, std::min(number_of_threads, number_of_segments));
+}
+
+// number_of_threads must have been clamped with clamp_number_of_threads.
+template<class Boundaries, class Task>
+void for_each_group(const Boundaries& boundaries, size_t number_of_threads, Task task)
+{
+    size_t number_of_segments = boundaries.size() - 1;
+    std::vector<std::exception_ptr> errors(number_of_threads);
+    auto run_group = [&](size_t thread_index)
+    {
+        try
+        {
+            task(thread_index,
+                boundaries[thread_index * number_of_segments / number_of_threads],
+                boundaries[(thread_index + 1) * number_of_segments / number_of_threads]);
+        }
+        catch(...)
+        {
+            errors[thread_index] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(size_t thread_index = 1; thread_index < number_of_threads; thread_index ++)
+        threads.emplace_back(run_group, thread_index);
+    run_group(0);
+    for(auto& thread: threads)
+        thread.join();
+    for(auto& error: errors)
+    {
+        if(error)
+            std::rethrow_exception(error);
+    }
+}
+
+}
+
+// Calls task(thread_index, first, last) for each group of segments, the
+// first group is processed by the calling thread. The first exception 
+// thrown by a task is rethrown once all the threads are joined.
+template<class List, class Task>
+void for_each_group(List& list, size_t number_of_threads, Task task)
+{
+    auto boundaries = list.segments();
+    detail::for_each_group(boundaries, 
+        detail::clamp_number_of_threads(number_of_threads, boundaries.size() - 1), 
+        std::move(task));
+}
+
+template<class List, class Function>
+void for_each(List& list, Function function, 
+    size_t number_of_threads = default_number_of_threads())
+{
+    for_each_group(list, number_of_threads, 
+        [&function](size_t, auto first, auto last)
+        {
+            for(; first != last; ++first)
+                function(*first);
+        });
+}
+
+// Computes reduce(...reduce(reduce(init, transform(x0)), transform(x1))...)
+// where reduce must be associative: each thread reduces its group, then
+// the partial results are reduced in the order of the list.
+template<class List, class T, class Reduce, class Transform>
+T transform_reduce(List& list, T init, Reduce reduce, Transform transform,
+    size_t number_of_threads = default_number_of_threads())
+{
+    auto boundaries = list.segments();
+    number_of_threads = detail::clamp_number_of_threads(
+        number_of_threads, boundaries.size() - 1);
+    std::vector<std::optional<T>> partial_results(number_of_threads);
+    detail::for_each_group(boundaries, number_of_threads, 
+        [&](size_t thread_index, auto first, auto last)
+        {
+            if(first == last)
+                return;
+            T partial_result = transform(*first);
+            for(++first; first != last; ++first)
+                partial_result = reduce(std::move(partial_result), transform(*first));
+            partial_results[thread_index] = std::move(partial_result);
+        });
+
+    for(auto& partial_result: partial_results)
+    {
+        if(partial_result.has_value())
+            init = reduce(std::move(init), std::move(*partial_result));
+    }
+    return init;
+}
+
+template<class List, class T, class Reduce>
+T reduce(List& list, T init, Reduce reduce, 
+    size_t number_of_threads = default_number_of_threads())
+{
+    return transform_reduce(list, std::move(init), reduce, 
+        [](const auto& value) { return value; }, number_of_threads);
+}
+
+}
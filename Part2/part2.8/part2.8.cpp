@@ -0,0 +1,49 @@
+#include<chrono>
+#include<functional>
+#include<iostream>
+#include<string>
+
+#include"../part2.4/list.hpp"
+#include"parallel.hpp"
+
+int main(int argc, char* argv[])
+{
+    using clock_type = std::chrono::steady_clock;
+
+    const size_t number_of_elements = argc > 1 ? std::stoull(argv[1]) : 10000000;
+    const size_t number_of_threads = argc > 2 ? 
+        std::stoull(argv[2]) : parallel::default_number_of_threads();
+
+    List<int> list;
+    list.reserve(number_of_elements);
+    for(size_t i = 0; i < number_of_elements; i++)
+    {
+        if(i % 2 == 0)
+            list.push_back((int)(i % 1000));
+        else
+            list.push_front((int)(i % 1000));
+    }
+
+    auto start = clock_type::now();
+    long long sequential_sum = 0;
+    for(auto it = list.begin(); it != list.end(); it++)
+        sequential_sum += *it;
+    auto sequential_time = clock_type::now() - start;
+
+    start = clock_type::now();
+    long long parallel_sum = parallel::transform_reduce(list, 0LL, std::plus<>(), 
+        [](int value) { return (long long)value; }, number_of_threads);
+    auto parallel_time = clock_type::now() - start;
+
+    long long number_of_even_values = parallel::transform_reduce(list, 0LL, std::plus<>(), 
+        [](int value) { return value % 2 == 0 ? 1LL : 0LL; }, number_of_threads);
+    parallel::for_each(list, [](int& value) { value *= 2; }, number_of_threads);
+
+    std::cout << "Sum: " << sequential_sum << " / " << parallel_sum 
+        << ", even values: " << number_of_even_values << "\n";
+    std::cout << "Sequential: " 
+        << std::chrono::duration_cast<std::chrono::milliseconds>(sequential_time).count() 
+        << "ms, parallel (" << number_of_threads << " threads): "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(parallel_time).count() 
+        << "ms\n";
+}
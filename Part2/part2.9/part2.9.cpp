@@ -0,0 +1,280 @@
+#include<deque>
+#include<exception>
+#include<iostream>
+#include<memory>
+#include<stdexcept>
+
+#include"../../tracing.hpp"
+
+class invalid_iterator: std::exception
+{
+private:
+    const char* m_message;
+public:
+    invalid_iterator(): m_message("invalid iterator") {}
+    invalid_iterator(const char* const &aMessage):
+        m_message(aMessage) {}
+    const char* what() const noexcept override { return m_message; }
+};
+
+// List of part2.2 extended with a skip index: every skip_interval nodes, 
+// a reference to the node is stored in a deque. Each node records its 
+// position relative to the first element ever inserted. As the elements
+// are only inserted at both ends, these positions never change and the
+// deque gives the node preceding any position by a division, the 
+// remaining steps are less than skip_interval.
+template<typename T>
+class List
+{
+private:
+    using position_type = long long;
+
+    struct Node
+    {
+    private:
+        T m_value;
+        std::shared_ptr<Node> m_next_node;
+        position_type m_position;
+
+    public:
+        Node(T aValue, position_type thePosition): 
+            m_value(aValue), m_next_node(), m_position(thePosition)
+            {}
+        Node(T aValue, std::shared_ptr<Node>& theNextNode, position_type thePosition):
+            m_value(aValue), m_next_node(theNextNode), m_position(thePosition)
+            {}
+        
+        void insert_after(T aValue)
+        {
+            m_next_node = std::make_shared<Node>(aValue, m_next_node, m_position + 1);
+        }
+        std::shared_ptr<Node>& next() { return m_next_node; }
+        T& value() { return m_value; }
+        T value() const { return m_value; }
+        position_type position() const { return m_position; }
+    };
+
+    using version_type = unsigned;
+
+    static constexpr position_type skip_interval = 64;
+
+    std::shared_ptr<Node> m_front;
+    std::shared_ptr<Node> m_back;
+    version_type m_version;
+    // Position of the first element and position after the last element.
+    position_type m_front_position;
+    position_type m_end_position;
+    // m_skip_nodes[i] is at the position m_first_skip_position + i * skip_interval.
+    std::deque<std::shared_ptr<Node>> m_skip_nodes;
+    position_type m_first_skip_position;
+
+    static bool is_skip_position(position_type position)
+    {
+        return position % skip_interval == 0;
+    }
+
+    // Returns the node at the position, the position must be in 
+    // [m_front_position, m_end_position).
+    std::shared_ptr<Node> find(position_type position) const
+    {
+        std::shared_ptr<Node> node = m_front;
+        if(!m_skip_nodes.empty() && position >= m_first_skip_position)
+            node = m_skip_nodes[
+                (size_t)((position - m_first_skip_position) / skip_interval)];
+        for(auto steps = position - node->position(); steps > 0; steps --)
+            node = node->next();
+        return node;
+    }
+
+public:
+    using value_type = T;
+    using pointer = value_type*;
+    using reference = T&;
+    using size_type = size_t;
+
+    class iterator
+    {
+    private:
+        friend class List<T>;
+        std::shared_ptr<Node> m_current;
+        const List<T>* m_list;
+        typename List<T>::version_type m_version;
+        void check_if_is_valid() const
+        {
+            if(m_version != m_list->m_version)
+            {
+                TRACE_COUNT(invalid_iterators, 1);
+                throw invalid_iterator();
+            }
+        }
+
+    public:        
+        using difference_type = typename std::iterator_traits<T*>::difference_type;
+        using value_type = typename std::iterator_traits<T*>::value_type;
+        using pointer = typename std::iterator_traits<T*>::pointer;
+        using reference = typename std::iterator_traits<T*>::reference;
+        using iterator_category = typename std::forward_iterator_tag;
+        using iterator_concept = typename std::forward_iterator_tag;
+
+        iterator(const List<T>& theList):
+             m_current(), m_list(&theList),
+             m_version(theList.m_version) {}
+        iterator(const List<T>& theList, 
+            const std::shared_ptr<Node>& node):
+            m_current(node), m_list(&theList), 
+            m_version(theList.m_version) {}
+        iterator& operator++()
+        {
+            check_if_is_valid();
+            if(m_current != NULL)
+                m_current = m_current->next();
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            check_if_is_valid();
+            auto result = iterator(*this);
+            if(m_current != NULL)
+                m_current = m_current->next();
+            return result;
+        }
+        reference operator *()
+        {
+            check_if_is_valid();
+            return m_current->value();
+        }
+        pointer operator ->()
+        {
+            check_if_is_valid();
+            return &(m_current->value());
+        }
+        bool operator == (const iterator& another) const
+        { 
+            return m_list == another.m_list 
+                && m_version == another.m_version 
+                && m_current == another.m_current; 
+        }
+        bool operator != (const iterator& another) const
+        { 
+            return !(*this == another); 
+        }
+    };
+
+    List(): 
+        m_front(), m_back(), m_version(0), 
+        m_front_position(0), m_end_position(0),
+        m_skip_nodes(), m_first_skip_position(0) 
+        {}
+    List(const List<T>&) = delete;
+    ~List()
+    {
+        // Release the nodes one by one, otherwise destroying the first 
+        // node would recursively destroy the whole chain.
+        m_skip_nodes.clear();
+        m_back.reset();
+        while(m_front != NULL)
+            m_front = std::move(m_front->next());
+    }
+    List<T>& operator = (const List<T>&) = delete;
+
+    iterator begin() { return iterator(*this, m_front); }
+    iterator end() { return iterator(*this); }
+
+    size_type size() const noexcept { return (size_type)(m_end_position - m_front_position); }
+
+    void push_front(T value)
+    {
+        if(m_front == NULL)
+        {
+            m_front = std::make_shared<Node>(value, m_end_position);
+            m_back = m_front;
+            m_end_position ++;
+        }
+        else
+        {
+            m_front_position --;
+            m_front = std::make_shared<Node>(value, m_front, m_front_position);
+        }
+        if(is_skip_position(m_front->position()))
+        {
+            m_skip_nodes.push_front(m_front);
+            m_first_skip_position = m_front->position();
+        }
+        m_version ++;
+    }
+    void push_back(T value)
+    {
+        if(m_back == NULL)
+        {
+            m_front = std::make_shared<Node>(value, m_end_position);
+            m_back = m_front;
+        }
+        else
+        {
+            m_back->insert_after(value);
+            m_back = m_back->next();
+        }
+        m_end_position ++;
+        if(is_skip_position(m_back->position()))
+        {
+            if(m_skip_nodes.empty())
+                m_first_skip_position = m_back->position();
+            m_skip_nodes.push_back(m_back);
+        }
+        m_version ++;
+    }
+
+    // Returns the index-th element, throws std::out_of_range if there is
+    // no such element.
+    reference at(size_type index)
+    {
+        if(index >= size())
+            throw std::out_of_range("List::at");
+        return find(m_front_position + (position_type)index)->value();
+    }
+
+    // Returns the iterator number_of_elements after position, or end() if
+    // the list has fewer elements.
+    iterator advance(iterator position, size_type number_of_elements)
+    {
+        position.check_if_is_valid();
+        if(position.m_current == NULL)
+            return position;
+        position_type target = position.m_current->position() 
+            + (position_type)number_of_elements;
+        if(target >= m_end_position)
+            return end();
+        return iterator(*this, find(target));
+    }
+};
+
+
+int main()
+{
+    List<int> list;
+    list.push_back(0);
+    for(int i = 1; i<1000; i++)
+    {
+        list.push_back(i);
+        list.push_front(i);
+    }
+
+    std::cout << "list.at(0) = " << list.at(0) << "\n";
+    std::cout << "list.at(999) = " << list.at(999) << "\n";
+    std::cout << "list.at(1500) = " << list.at(1500) << "\n";
+
+    // Read the list by pages of 500 elements.
+    for(auto it = list.begin(); it != list.end(); it = list.advance(it, 500))
+        std::cout << *it << "\n";
+
+    auto it = list.begin();
+    list.push_back(1000);
+    try
+    {
+        it = list.advance(it, 10);
+    }
+    catch(const invalid_iterator&)
+    {
+        std::cout << "Invalid iterator\n";
+    }
+}
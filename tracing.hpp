@@ -0,0 +1,219 @@
+#pragma once
+
+// Counters of the events that occur in the parsers and in the lists. The
+// instrumentation points are the TRACE_COUNT and TRACE_TIME macros, they
+// expand to nothing unless TRACING_ENABLED is defined (see the 
+// ENABLE_TRACING option of CMakeLists.txt).
+//
+// Each thread increments its own counters, which are stored in a block 
+// aligned on a cache line so that two threads never write to the same
+// line. The counters of all the threads are summed on demand.
+
+#if defined(TRACING_ENABLED)
+
+#include<algorithm>
+#include<atomic>
+#include<chrono>
+#include<cstdint>
+#include<mutex>
+#include<ostream>
+#include<string>
+#include<vector>
+
+namespace tracing
+{
+
+enum class counter
+{
+    bytes_read,
+    lines_scanned,
+    match_time_ns,
+    buffer_growths,
+    node_allocations,
+    invalid_iterators,
+    number_of_counters
+};
+
+constexpr size_t number_of_counters = (size_t)counter::number_of_counters;
+
+inline const char* name_of(counter aCounter)
+{
+    static const char* const names[number_of_counters] = {
+        "bytes_read", "lines_scanned", "match_time_ns", 
+        "buffer_growths", "node_allocations", "invalid_iterators" };
+    return names[(size_t)aCounter];
+}
+
+struct alignas(64) thread_counters
+{
+    // Only the owner thread writes the values, the atomics make the 
+    // concurrent reads of aggregate() well defined.
+    std::atomic<std::uint64_t> values[number_of_counters] = {};
+};
+
+class registry
+{
+private:
+    std::mutex m_mutex;
+    // Counters of the running threads.
+    std::vector<const thread_counters*> m_threads;
+    // Sum of the counters of the threads that have ended.
+    std::vector<std::uint64_t> m_retired = std::vector<std::uint64_t>(number_of_counters, 0);
+
+public:
+    static registry& instance()
+    {
+        static registry the_registry;
+        return the_registry;
+    }
+
+    void add_thread(const thread_counters& counters)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_threads.push_back(&counters);
+    }
+
+    // Called when the thread ends: its values are added to the retired 
+    // totals, so that the registry does not grow with every thread ever
+    // started.
+    void remove_thread(const thread_counters& counters)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for(size_t index = 0; index < number_of_counters; index ++)
+            m_retired[index] += counters.values[index].load(std::memory_order_relaxed);
+        m_threads.erase(std::find(m_threads.begin(), m_threads.end(), &counters));
+    }
+
+    std::vector<std::uint64_t> aggregate()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<std::uint64_t> totals = m_retired;
+        for(auto counters: m_threads)
+            for(size_t index = 0; index < number_of_counters; index ++)
+                totals[index] += counters->values[index].load(std::memory_order_relaxed);
+        return totals;
+    }
+
+    // The values of the running threads.
+    std::vector<std::vector<std::uint64_t>> per_thread()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<std::vector<std::uint64_t>> values;
+        for(auto counters: m_threads)
+        {
+            values.emplace_back(number_of_counters);
+            for(size_t index = 0; index < number_of_counters; index ++)
+                values.back()[index] = counters->values[index].load(std::memory_order_relaxed);
+        }
+        return values;
+    }
+
+    // The sum of the values of the threads that have ended.
+    std::vector<std::uint64_t> retired()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_retired;
+    }
+};
+
+// Counters of the calling thread, registered while the thread runs.
+struct registered_counters
+{
+    thread_counters counters;
+
+    registered_counters() { registry::instance().add_thread(counters); }
+    ~registered_counters() { registry::instance().remove_thread(counters); }
+    registered_counters(const registered_counters&) = delete;
+    registered_counters& operator = (const registered_counters&) = delete;
+};
+
+inline thread_counters& current_thread_counters()
+{
+    thread_local registered_counters registered;
+    return registered.counters;
+}
+
+inline void count(counter aCounter, std::uint64_t value = 1)
+{
+    auto& current_value = current_thread_counters().values[(size_t)aCounter];
+    // Single writer: a plain load and store is enough, no locked add.
+    current_value.store(current_value.load(std::memory_order_relaxed) + value, 
+        std::memory_order_relaxed);
+}
+
+// Adds the time spent in a scope to a counter.
+class scope_timer
+{
+private:
+    counter m_counter;
+    std::chrono::steady_clock::time_point m_start;
+
+public:
+    explicit scope_timer(counter aCounter):
+        m_counter(aCounter), m_start(std::chrono::steady_clock::now())
+        {}
+    ~scope_timer()
+    {
+        count(m_counter, (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_start).count());
+    }
+};
+
+// {"bytes_read": 1024, "lines_scanned": 10, ...}
+inline void write_json(std::ostream& stream)
+{
+    auto totals = registry::instance().aggregate();
+    stream << "{";
+    for(size_t index = 0; index < number_of_counters; index ++)
+        stream << (index == 0 ? "" : ", ") 
+            << "\"" << name_of((counter)index) << "\": " << totals[index];
+    stream << "}\n";
+}
+
+// Counter events of the Chrome trace format (chrome://tracing or 
+// Perfetto). The counter tracks belong to the process and not to the 
+// threads: the index of the thread is part of the name of the counter so
+// that each running thread gets its own tracks. The threads that have 
+// ended share the "ended threads" tracks.
+inline void write_chrome_trace(std::ostream& stream)
+{
+    auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto values = registry::instance().per_thread();
+    auto retired = registry::instance().retired();
+    stream << "{\"traceEvents\": [";
+    bool is_first = true;
+    for(size_t thread = 0; thread <= values.size(); thread ++)
+    {
+        bool is_retired = thread == values.size();
+        std::string track = is_retired ? "ended threads" : "thread " + std::to_string(thread);
+        for(size_t index = 0; index < number_of_counters; index ++)
+        {
+            stream << (is_first ? "\n" : ",\n") 
+                << "  {\"name\": \"" << track << " " << name_of((counter)index) 
+                << "\", \"ph\": \"C\", \"ts\": " << timestamp
+                << ", \"pid\": 0, \"tid\": " << thread
+                << ", \"args\": {\"value\": " 
+                << (is_retired ? retired[index] : values[thread][index]) << "}}";
+            is_first = false;
+        }
+    }
+    stream << "\n]}\n";
+}
+
+}
+
+#define TRACING_CONCATENATE_(first, second) first##second
+#define TRACING_CONCATENATE(first, second) TRACING_CONCATENATE_(first, second)
+
+#define TRACE_COUNT(name, value) \
+    ::tracing::count(::tracing::counter::name, (std::uint64_t)(value))
+#define TRACE_TIME(name) \
+    ::tracing::scope_timer TRACING_CONCATENATE(tracing_timer_, __LINE__)(::tracing::counter::name)
+
+#else
+
+#define TRACE_COUNT(name, value) ((void)0)
+#define TRACE_TIME(name) ((void)0)
+
+#endif